@@ -0,0 +1,9 @@
+#version 330 core
+
+in vec4 vCol;
+out vec4 color;
+
+void main()
+{
+    color = vCol;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#version 330 core
+// One instance per polyline segment (start -> end), expanded into a quad here -- see Mesh2D::AddLines.
+// prev / next are the neighbouring points (equal to start / end at the ends of a polyline), used for the joins.
+layout (location = 0) in vec2 prev;
+layout (location = 1) in vec2 start;
+layout (location = 2) in vec2 end;
+layout (location = 3) in vec2 next;
+layout (location = 4) in float startWidth;
+layout (location = 5) in float endWidth;
+layout (location = 6) in vec4 col;
+
+out vec4 vCol;
+
+uniform mat4 model;
+
+const float EPSILON = 1e-12;
+const float MITER_LIMIT = 2.0; // joins sharper than this are flattened instead of spiking out
+
+// (along, side): triangles start-, start+, end- and start+, end-, end+ -- same winding as the old CPU path
+const vec2 CORNERS[6] = vec2[6](
+    vec2(0.0, -1.0), vec2(0.0, 1.0), vec2(1.0, -1.0),
+    vec2(0.0, 1.0), vec2(1.0, -1.0), vec2(1.0, 1.0)
+);
+
+vec2 Normal(vec2 dir) {
+    return vec2(-dir.y, dir.x);
+}
+
+// offset direction at a joint, scaled so the segment keeps its width through the join
+vec2 Miter(vec2 normal, vec2 neighbourDir) {
+    if (dot(neighbourDir, neighbourDir) < EPSILON) return normal; // end of the polyline
+
+    vec2 miter = normal + Normal(normalize(neighbourDir));
+    if (dot(miter, miter) < EPSILON) return normal; // folds back on itself
+
+    miter = normalize(miter);
+    return miter / max(dot(miter, normal), 1.0 / MITER_LIMIT);
+}
+
+void main()
+{
+    vec2 dir = end - start;
+
+    // padding between polylines (negative width) or a zero length segment: collapse, nothing is rasterized
+    if (startWidth < 0.0 || endWidth < 0.0 || dot(dir, dir) < EPSILON) {
+        gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+        vCol = col;
+        return;
+    }
+
+    vec2 normal = Normal(normalize(dir));
+    vec2 corner = CORNERS[gl_VertexID];
+
+    vec2 pos = (corner.x == 0.0) ? start : end;
+    vec2 offset = (corner.x == 0.0) ? Miter(normal, start - prev) * startWidth : Miter(normal, next - end) * endWidth;
+
+    gl_Position = model * vec4(pos + offset * corner.y, 0.0f, 1.0f);
+    vCol = col;
+}
@@ -36,6 +36,13 @@ public:
     enum TransformAxisLock {
         LOCK_NONE, LOCK_X, LOCK_Y
     };
+    enum AnimatableParam { // float parameters that can be keyframed, see AnimatableParams for their labels
+        PARAM_X, PARAM_Y, PARAM_Z,
+        PARAM_ROT_X, PARAM_ROT_Y, PARAM_ROT_Z,
+        PARAM_SAMPLE_LENGTH,
+        PARAM_SCALE_RADIUS, PARAM_SCALE_Y, PARAM_SCALE_Z, PARAM_LEAN_SCALAR,
+        PARAM_COUNT
+    };
     enum EditingTool {
         TOOL_BRUSH,
         TOOL_ERASE,
@@ -0,0 +1,40 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_ANIMATABLEPARAMS_H
+#define SENIORRESEARCH_ANIMATABLEPARAMS_H
+
+
+#include <array>
+#include <optional>
+#include <string_view>
+#include "../Enums.h"
+
+// Labels of Enums::AnimatableParam. Animation is looked up by param at runtime; labels are only used for the
+// parameter UI and wherever params are written out (project files, journals), so saved files don't depend on
+// the order of the enum.
+class AnimatableParams {
+public:
+	[[nodiscard]] static constexpr const char* Label(Enums::AnimatableParam param) { return LABELS[param]; }
+
+	[[nodiscard]] static constexpr std::optional<Enums::AnimatableParam> FromLabel(std::string_view label) {
+		for (int param = 0; param < Enums::PARAM_COUNT; param++) {
+			if (label == LABELS[param]) return (Enums::AnimatableParam) param;
+		}
+		return std::nullopt;
+	}
+
+private:
+	static constexpr std::array<const char*, Enums::PARAM_COUNT> LABELS = {
+		"x", "y", "z",
+		"rot-x", "rot-y", "rot-z",
+		"sample-length",
+		"scale-radius", "scale-y", "scale-z", "lean-scalar",
+	};
+};
+
+static_assert(AnimatableParams::FromLabel("lean-scalar") == Enums::PARAM_LEAN_SCALAR, "AnimatableParams::LABELS out of order");
+
+
+#endif //SENIORRESEARCH_ANIMATABLEPARAMS_H
@@ -4,9 +4,54 @@
 
 #include "Animator.h"
 
+#include <algorithm>
+
 Animator::Animator() {
-    keyFrameLayers[Enums::MODE_PLOT] = KeyFrameLayer<std::vector<glm::vec2>>();
-    keyFrameLayers[Enums::MODE_GRAPH_Y] = KeyFrameLayer<std::vector<glm::vec2>>();
-    keyFrameLayers[Enums::MODE_GRAPH_Z] = KeyFrameLayer<std::vector<glm::vec2>>();
-    keyFrameLayers[Enums::MODE_CROSS_SECTION] = KeyFrameLayer<std::vector<glm::vec2>>();
-}
\ No newline at end of file
+    keyFrameLayers[Enums::MODE_PLOT] = KeyFrameLayer<PackedPolyline>();
+    keyFrameLayers[Enums::MODE_GRAPH_Y] = KeyFrameLayer<PackedPolyline>();
+    keyFrameLayers[Enums::MODE_GRAPH_Z] = KeyFrameLayer<PackedPolyline>();
+    keyFrameLayers[Enums::MODE_CROSS_SECTION] = KeyFrameLayer<PackedPolyline>();
+}
+
+bool Animator::IsEvaluatedAt(float time) const {
+	return evaluatedTime == ClampToAnimatedRange(time) && evaluatedRevision == GetRevision();
+}
+
+void Animator::MarkEvaluatedAt(float time) {
+	evaluatedTime = ClampToAnimatedRange(time);
+	evaluatedRevision = GetRevision();
+}
+
+float Animator::ClampToAnimatedRange(float time) const {
+	const auto range = GetAnimatedRange();
+	if (!range) return 0.0f; // nothing animated
+	return std::clamp(time, range->first, range->second);
+}
+
+std::optional<std::pair<float, float>> Animator::GetAnimatedRange() const {
+	float minTime = INFINITY, maxTime = -INFINITY;
+	const auto Extend = [&](const auto& layer) {
+		if (layer.frames.empty()) return;
+		minTime = std::min(minTime, layer.frames.front().time);
+		maxTime = std::max(maxTime, layer.frames.back().time);
+	};
+
+	for (const auto& [mode, layer] : keyFrameLayers) Extend(layer);
+	for (const auto& layer : floatKeyFrameLayers) if (layer) Extend(*layer);
+
+	if (minTime > maxTime) return std::nullopt;
+	return std::make_pair(minTime, maxTime);
+}
+
+uint64_t Animator::GetRevision() const {
+	uint64_t revision = 0;
+	for (const auto& [mode, layer] : keyFrameLayers) revision = std::max(revision, layer.GetRevision());
+	for (const auto& layer : floatKeyFrameLayers) if (layer) revision = std::max(revision, layer->GetRevision());
+	return revision;
+}
+
+bool Animator::HasKeyFrames() const {
+	for (const auto& [mode, layer] : keyFrameLayers) if (!layer.frames.empty()) return true;
+	for (const auto& layer : floatKeyFrameLayers) if (layer && !layer->frames.empty()) return true;
+	return false;
+}
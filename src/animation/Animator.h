@@ -6,8 +6,11 @@
 #define SENIORRESEARCH_ANIMATOR_H
 
 #include <unordered_map>
+#include <cmath>
 #include "../util/Includes.h"
 #include "KeyFrameLayer.h"
+#include "AnimatableParams.h"
+#include <array>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/unordered_map.hpp>
 
@@ -23,6 +26,16 @@ public:
         return keyFrameLayers[drawMode].HasKeyFrameAtTime(time);
     }
 
+    // true if the object already shows its animated state at time: no keyframe was edited since the last
+    // evaluation, and time maps to the same point of the animated range (times outside it clamp to its ends)
+    [[nodiscard]] bool IsEvaluatedAt(float time) const;
+    void MarkEvaluatedAt(float time);
+    [[nodiscard]] uint64_t GetRevision() const; // newest edit of any layer
+    [[nodiscard]] bool HasKeyFrames() const;
+    // times of the first and last keyframe over every layer, empty when nothing is animated
+    [[nodiscard]] std::optional<std::pair<float, float>> GetAnimatedRange() const;
+
+
 	struct SettableFloatKeyFrameLayer { // TODO: remove this struct!
 		KeyFrameLayer<float> layer;
 	private:
@@ -37,8 +50,13 @@ public:
 private:
 
 	float currentTime = 0.0f;
-    std::unordered_map<Enums::DrawMode, KeyFrameLayer<std::vector<glm::vec2>>> keyFrameLayers;
-	std::unordered_map<std::string, SettableFloatKeyFrameLayer> floatKeyFrameLayers;
+	float evaluatedTime = NAN; // clamped, NAN until the first evaluation
+	uint64_t evaluatedRevision = 0;
+
+	[[nodiscard]] float ClampToAnimatedRange(float time) const;
+
+    std::unordered_map<Enums::DrawMode, KeyFrameLayer<PackedPolyline>> keyFrameLayers;
+	std::array<std::optional<KeyFrameLayer<float>>, Enums::PARAM_COUNT> floatKeyFrameLayers; // by param, empty when not animated
 
 	friend class boost::serialization::access;
 	template<class Archive>
@@ -46,11 +64,26 @@ private:
 	{
 		ar & currentTime;
 		ar & keyFrameLayers;
-		ar & floatKeyFrameLayers;
+
+		// float layers are stored by label
+		std::unordered_map<std::string, SettableFloatKeyFrameLayer> labeledFloatLayers;
+		if constexpr (Archive::is_saving::value) {
+			for (int param = 0; param < Enums::PARAM_COUNT; param++) {
+				if (floatKeyFrameLayers[param]) labeledFloatLayers[AnimatableParams::Label((Enums::AnimatableParam) param)] = {*floatKeyFrameLayers[param]};
+			}
+		}
+		ar & labeledFloatLayers;
+		if constexpr (Archive::is_loading::value) {
+			for (auto& [label, settableLayer] : labeledFloatLayers) {
+				if (const auto param = AnimatableParams::FromLabel(label)) floatKeyFrameLayers[*param] = std::move(settableLayer.layer);
+				else LOG("[Error]: no animatable parameter \"%s\", dropping its keyframes", label.c_str());
+			}
+		}
 	}
 
     friend class Timeline;
     friend struct TimelineSelection;
+    friend class Journal;
 };
 
 
@@ -11,33 +11,53 @@
 #include "blending/LinearBlendMode.h"
 #include "blending/BlendModeManager.h"
 #include "blending/BlendModes.h"
+#include "blending/BlendCurves.h"
+#include "../util/PackedPolyline.h"
 #include <vector>
+#include <type_traits>
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/is_bitwise_serializable.hpp>
+#include <boost/serialization/version.hpp>
+
+// what a layer of stored T evaluates to
+template <typename T>
+struct KeyFrameValue { using Evaluated = T; };
+
+template <>
+struct KeyFrameValue<PackedPolyline> { using Evaluated = Vec2List; }; // strokes are kept packed, decoded when evaluated
 
 template <typename T>
 struct KeyFrame {
+    using Evaluated = typename KeyFrameValue<T>::Evaluated;
+
     T val {};
     float time {};
     int blendModeID = 0;
 
-    static T GetAnimatedValueAtT(const KeyFrame<T>& frame1, const KeyFrame<T>& frame2, float t) {
-        if (t == 0.0f) return frame1.val;
-        if (t == 1.0f) return frame2.val;
+    static Evaluated GetAnimatedValueAtT(const KeyFrame<T>& frame1, const KeyFrame<T>& frame2, float t) {
+        if (t == 0.0f) return Evaluate(frame1.val);
+        if (t == 1.0f) return Evaluate(frame2.val);
         return Lerp(frame1, frame2, t);
     }
 
+    static float Evaluate(float val) { return val; }
+    static Vec2List Evaluate(const PackedPolyline& val) { return val.Decode(); }
+
     static float Lerp(const KeyFrame<float>& frame1, const KeyFrame<float>& frame2, float t) {
         return frame1.val + (frame2.val - frame1.val) * t;
     }
 
     static float RemapTime(float t, const KeyFrame<T>& frame1, const KeyFrame<T>& frame2) { // TODO: allow t outside {0, 1} for recoil
-        return BlendMode::Apply(BlendModes::Get(frame1.blendModeID), BlendModes::Get(frame2.blendModeID), t);
+        return BlendCurves::Apply(frame1.blendModeID, frame2.blendModeID, t);
     }
 
 
-    static std::vector<glm::vec2> Lerp(const KeyFrame<std::vector<glm::vec2>>& frame1, const KeyFrame<std::vector<glm::vec2>>& frame2, float t) {
+    static std::vector<glm::vec2> Lerp(const KeyFrame<PackedPolyline>& frame1, const KeyFrame<PackedPolyline>& frame2, float t) {
+        thread_local Vec2List line1, line2; // decode scratch, meshes may be generated on worker threads
+        frame1.val.DecodeInto(line1);
+        frame2.val.DecodeInto(line2);
         // TODO: better count??
-        return LineLerper::MorphPolyLine(frame1.val, frame2.val, t, (int) std::max(frame1.val.size(), frame2.val.size()));
+        return LineLerper::MorphPolyLine(line1, line2, t, (int) std::max(line1.size(), line2.size()));
     }
 
 private:
@@ -45,10 +65,24 @@ private:
     template<class Archive>
     void serialize(Archive & ar, const unsigned int version)
     {
-        ar & val;
+        const int VERSION_PACKED_POLYLINE = 1;
+        if constexpr (std::is_same_v<T, PackedPolyline>) {
+            if (version >= VERSION_PACKED_POLYLINE) {
+                ar & val;
+            } else { // older files store strokes as raw points
+                Vec2List points;
+                ar & points;
+                val.Encode(points);
+            }
+        } else {
+            ar & val;
+        }
         ar & time;
         ar & blendModeID;
     }
 };
 
+BOOST_IS_BITWISE_SERIALIZABLE(KeyFrame<float>)
+BOOST_CLASS_VERSION(KeyFrame<PackedPolyline>, 1)
+
 #endif //SENIORRESEARCH_KEYFRAME_H
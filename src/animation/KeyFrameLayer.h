@@ -7,15 +7,32 @@
 
 #include "../util/Includes.h"
 #include "KeyFrame.h"
+#include "MorphCache.h"
 #include "../vendor/glm/vec2.hpp"
 #include "../gl/Mesh2D.h"
 #include <functional>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
 #include <boost/serialization/access.hpp>
 
+// process-wide edit counter, so the most recently edited layer always holds the highest revision
+class KeyFrameRevision {
+public:
+    static uint64_t Next() { return ++counter; }
+
+private:
+    static inline std::atomic<uint64_t> counter = 0;
+};
+
 template <class T>
 class KeyFrameLayer {
 public:
 
+    [[nodiscard]] uint64_t GetRevision() const { return revision; }
+    void MarkEdited() { revision = KeyFrameRevision::Next(); } // after editing frames in place (blend modes)
+
     void MoveFromTimeToTime(float initTime, float newTime) {
         if (initTime == newTime) return;
 
@@ -31,12 +48,91 @@ public:
     }
 
     void RemoveAtTime(float time) {
-        for (int i = 0; i < frames.size(); i++) {
-            if (frames[i].time == time) {
-                frames.erase(frames.begin() + i);
-                return;
+        const int i = IndexAtTime(time);
+        if (i == -1) return;
+
+        frames.erase(frames.begin() + i);
+        MarkEdited();
+    }
+
+    // BATCH EDITS -- each rebuilds the layer in one pass rather than a remove + insert per frame
+
+    // moves the frames at times by amount. A frame whose destination is held by a frame that stays put doesn't move,
+    // same as MoveFromTimeToTime. onMove sees each move that happened, in an order that replays one at a time.
+    // Returns the frames that were at times, at their new positions.
+    std::vector<KeyFrame<T>*> MoveAll(const std::vector<float>& times, float amount, const std::function<void(float, float)>& onMove = {}) {
+        const std::vector<int> selected = IndicesAtTimes(times);
+        if (amount == 0.0f || selected.empty()) return FramesAt(selected);
+
+        std::vector<bool> isSelected(frames.size(), false), moves(frames.size(), false);
+        for (int i : selected) isSelected[i] = true;
+
+        // leading edge first: frames ahead are settled, so a blocked frame also blocks the one behind it
+        for (int j = 0; j < selected.size(); j++) {
+            const int i = (amount > 0.0f) ? selected[selected.size() - 1 - j] : selected[j];
+            const float newTime = frames[i].time + amount;
+            const int blocker = IndexAtTime(newTime);
+            if (blocker != -1 && (!isSelected[blocker] || !moves[blocker])) {
+                LOG("[Error]: overlapping keyframe during move -- ABORTING OPERATION");
+                continue;
+            }
+            moves[i] = true;
+            if (onMove) onMove(frames[i].time, newTime);
+        }
+
+        // moved frames keep their order, so the result is a merge of two sorted runs
+        std::vector<int> staying, moving;
+        for (int i = 0; i < frames.size(); i++) (moves[i] ? moving : staying).push_back(i);
+        for (int i : moving) frames[i].time += amount;
+
+        std::vector<int> order(frames.size());
+        std::merge(staying.begin(), staying.end(), moving.begin(), moving.end(), order.begin(),
+                   [&](int a, int b) { return frames[a].time < frames[b].time; });
+
+        std::vector<int> newIndexOf(frames.size());
+        for (int i = 0; i < order.size(); i++) newIndexOf[order[i]] = i;
+
+        Rebuild(order, {});
+
+        std::vector<int> movedSelection;
+        for (int i : selected) movedSelection.push_back(newIndexOf[i]);
+        return FramesAt(movedSelection);
+    }
+
+    void RemoveAll(const std::vector<float>& times) {
+        const std::vector<int> removed = IndicesAtTimes(times);
+        if (removed.empty()) return;
+
+        std::vector<int> order;
+        for (int i = 0, r = 0; i < frames.size(); i++) {
+            if (r < removed.size() && removed[r] == i) r++;
+            else order.push_back(i);
+        }
+        Rebuild(order, {});
+    }
+
+    // inserts (or overwrites at equal times) every frame, later entries win over earlier ones at the same time
+    void InsertAll(std::vector<KeyFrame<T>> newFrames) {
+        if (newFrames.empty()) return;
+
+        std::stable_sort(newFrames.begin(), newFrames.end(), [](const KeyFrame<T>& a, const KeyFrame<T>& b) { return a.time < b.time; });
+        std::vector<KeyFrame<T>> inserted;
+        for (auto& frame : newFrames) {
+            if (!inserted.empty() && inserted.back().time == frame.time) inserted.back() = std::move(frame);
+            else inserted.push_back(std::move(frame));
+        }
+
+        // merge, -1 - k stands for inserted[k]
+        std::vector<int> order;
+        int i = 0, k = 0;
+        while (i < frames.size() || k < inserted.size()) {
+            if (k == inserted.size() || (i < frames.size() && frames[i].time < inserted[k].time)) order.push_back(i++);
+            else {
+                if (i < frames.size() && frames[i].time == inserted[k].time) i++; // overwritten
+                order.push_back(-1 - k++);
             }
         }
+        Rebuild(order, std::move(inserted));
     }
 
     static float RowToHeight(int row) {
@@ -67,7 +163,11 @@ public:
             float t = (time - frame1.time) / (frame2.time - frame1.time); // Linear
             // TODO: calc using blendmodes!
 
-            for (int i = 0; i < frames.size(); i++) {
+            // only frames in view, plus the one either side whose curve crosses into it
+            const int first = std::max((int) (LowerBound(minVisibleTime) - frames.begin()) - 1, 0);
+            const int last = std::min((int) (UpperBound(maxVisibleTime) - frames.begin()), (int) frames.size() - 1);
+
+            for (int i = first; i <= last; i++) {
                 auto& frame = frames[i];
                 bool selected = (frame.time == frame1.time || frame.time == frame2.time);
 
@@ -83,7 +183,7 @@ public:
                     return glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
                 }();
                 canvas.AddPolygonOutline({frameX, RowToHeight(line)}, 0.03f, frame.blendModeID == 0 ? 3 : 10, color);
-                if (i != frames.size() - 1) {
+                if (i != last) {
                     glm::vec2 p1 = glm::vec2(frameX, RowToHeight(line) - 0.1f);
                     glm::vec2 p2 = glm::vec2(timeToX(frames[i + 1].time), RowToHeight(line) + 0.1f);
 
@@ -95,17 +195,11 @@ public:
                     };
 
                     {
-                        int pCount = std::round((frames[i + 1].time - frame.time) * 10.0f) * 4 + 1;
+                        const std::vector<glm::vec2>& curve = CurveBetween(i);
                         std::vector<glm::vec2> vec;
-                        vec.reserve(pCount);
+                        vec.reserve(curve.size());
 
-                        for (int drawP = 0; drawP <= pCount; drawP++) {
-                            if (drawP == pCount) {
-                                vec.push_back({p2});
-                                continue;
-                            }
-                            vec.push_back(GetGraphPosAtT((float) drawP / (float) pCount, frame, frames[i + 1]));
-                        }
+                        for (const glm::vec2& unit : curve) vec.push_back(p1 + unit * (p2 - p1));
 
                         canvas.AddLines(vec, lineColor, 0.003f);
                     }
@@ -125,56 +219,42 @@ public:
         return !frames.empty();
     }
 
-	T GetAnimatedVal(float time) {
+	typename KeyFrame<T>::Evaluated GetAnimatedVal(float time) {
 		auto upper = std::upper_bound(frames.begin(), frames.end(), time,
 		                              [](float value, const KeyFrame<T>& frame) {
 			                              return value < frame.time;
 		                              }
 		);
-		const KeyFrame<T>& frame1 = [&]{
+		const KeyFrame<T>& frame1 = [&]() -> const KeyFrame<T>& {
 			if (upper == frames.begin()) return upper[0];
 			if (upper == frames.end()) return frames.back();
 			return upper[-1];
 		}();
-		const KeyFrame<T>& frame2 = [&]{
+		const KeyFrame<T>& frame2 = [&]() -> const KeyFrame<T>& {
 			if (upper == frames.end()) return frames.back();
 			return upper[0];
 		}();
 
-		float t = (time - frame1.time) / (frame2.time - frame1.time); // Linear
+		if (frame1.time == frame2.time) return KeyFrame<T>::Evaluate(frame1.val); // outside the animated range
 
-		if (frame1.time == frame2.time) {
-			t = -1.0f;
-		} else {
-			t = KeyFrame<T>::RemapTime(t, frame1, frame2);
-		}
+		const float t = KeyFrame<T>::RemapTime((time - frame1.time) / (frame2.time - frame1.time), frame1, frame2); // Linear
 
+		if constexpr (MORPHS) {
+			if (t != 0.0f && t != 1.0f) return LineLerper::Lerp(*MorphCache::Get(frame1.val, frame2.val), t);
+		}
 		return KeyFrame<T>::GetAnimatedValueAtT(frame1, frame2, t);
 	}
 
     void Insert(KeyFrame<T> frame) {
-        const float time = frame.time;
-
-        for (int i = 0; i < frames.size(); i++) {
-            float otherTime = frames[i].time;
-            if (time == otherTime) {
-                frames[i] = frame;
-            }  else if (time < otherTime) {
-                frames.insert(frames.begin() + i, {frame});
-            } else {
-                continue;
-            }
-            return;
-        }
-        frames.push_back(frame);
+        MarkEdited();
+
+        const auto lower = LowerBound(frame.time);
+        if (lower != frames.end() && lower->time == frame.time) *lower = std::move(frame);
+        else frames.insert(lower, std::move(frame));
     }
 
-    [[nodiscard]] bool HasKeyFrameAtTime(float time)  {
-        for (KeyFrame<T>& keyFrame : frames) {
-            if (keyFrame.time == time) return true;
-            if (keyFrame.time > time) return false;
-        }
-        return false;
+    [[nodiscard]] bool HasKeyFrameAtTime(float time) const {
+        return IndexAtTime(time) != -1;
     }
 
     std::optional<KeyFrame<T>*> KeyFrameBelow(float time) {
@@ -213,15 +293,100 @@ private:
         ar & frames;
     }
 
-    KeyFrame<T> ProcureKeyFrameAtTime(float time) {
-        for (int i = 0; i < frames.size(); i++) {
-            if (frames[i].time == time) {
-                return frames[i];
-            }
+    uint64_t revision = KeyFrameRevision::Next(); // fresh per layer, so cached meshes never outlive a project reload
+
+    static constexpr bool MORPHS = std::is_same_v<T, PackedPolyline>;
+
+    // polyline layers morph through MorphCache, keyed by stroke content rather than frame index, so edits and moves
+    // need no bookkeeping here
+    // the blend curve between frames i and i + 1, tessellated in the unit square for the timeline. Revalidated against
+    // the pair on every use rather than invalidated by edits, so inserts and moves that shift indices are harmless.
+    struct CurveSamples {
+        float time1, time2;
+        int blendModeID1, blendModeID2;
+        uint64_t curveVersion; // BlendCurves::GetVersion
+        std::vector<glm::vec2> points;
+    };
+    std::vector<std::shared_ptr<const CurveSamples>> curveCache; // shared, so copying a layer doesn't copy the points
+
+    const std::vector<glm::vec2>& CurveBetween(int pairIndex) {
+        if (curveCache.size() != frames.size()) curveCache.resize(frames.size());
+
+        const KeyFrame<T>& frame1 = frames[pairIndex];
+        const KeyFrame<T>& frame2 = frames[pairIndex + 1];
+        auto& cached = curveCache[pairIndex];
+        if (cached && cached->time1 == frame1.time && cached->time2 == frame2.time && cached->blendModeID1 == frame1.blendModeID
+            && cached->blendModeID2 == frame2.blendModeID && cached->curveVersion == BlendCurves::GetVersion()) {
+            return cached->points;
         }
+
+        auto samples = std::make_shared<CurveSamples>(CurveSamples{frame1.time, frame2.time, frame1.blendModeID, frame2.blendModeID, BlendCurves::GetVersion(), {}});
+        const int pCount = (int) std::round((frame2.time - frame1.time) * 10.0f) * 4 + 1;
+        samples->points.reserve(pCount + 1);
+        for (int drawP = 0; drawP < pCount; drawP++) {
+            const float t = (float) drawP / (float) pCount;
+            samples->points.emplace_back(t, KeyFrame<T>::RemapTime(t, frame1, frame2));
+        }
+        samples->points.emplace_back(1.0f, 1.0f);
+
+        cached = std::move(samples);
+        return cached->points;
+    }
+
+    KeyFrame<T> ProcureKeyFrameAtTime(float time) {
+        const int i = IndexAtTime(time);
+        if (i != -1) return frames[i];
+
         LOG("[CRITICAL ERROR]: NO KEYFRAME FOUND AT TIME!");
         return frames[0];
     }
+
+    [[nodiscard]] typename std::vector<KeyFrame<T>>::const_iterator LowerBound(float time) const {
+        return std::lower_bound(frames.begin(), frames.end(), time, [](const KeyFrame<T>& frame, float value) { return frame.time < value; });
+    }
+
+    [[nodiscard]] typename std::vector<KeyFrame<T>>::iterator LowerBound(float time) {
+        return std::lower_bound(frames.begin(), frames.end(), time, [](const KeyFrame<T>& frame, float value) { return frame.time < value; });
+    }
+
+    [[nodiscard]] typename std::vector<KeyFrame<T>>::const_iterator UpperBound(float time) const {
+        return std::upper_bound(frames.begin(), frames.end(), time, [](float value, const KeyFrame<T>& frame) { return value < frame.time; });
+    }
+
+    [[nodiscard]] int IndexAtTime(float time) const { // -1 if there is no frame at exactly time
+        const auto lower = LowerBound(time);
+        return (lower != frames.end() && lower->time == time) ? (int) (lower - frames.begin()) : -1;
+    }
+
+    [[nodiscard]] std::vector<int> IndicesAtTimes(const std::vector<float>& times) const { // ascending, missing times skipped
+        std::vector<int> indices;
+        for (float time : times) {
+            const int i = IndexAtTime(time);
+            if (i != -1) indices.push_back(i);
+        }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        return indices;
+    }
+
+    std::vector<KeyFrame<T>*> FramesAt(const std::vector<int>& indices) {
+        std::vector<KeyFrame<T>*> framePtrs;
+        for (int i : indices) framePtrs.push_back(&frames[i]);
+        return framePtrs;
+    }
+
+    // order lists the new layer front to back: i >= 0 is the current frames[i], -1 - k is inserted[k].
+    // Frames are written back into the same storage where it fits, so selections pointing into the layer stay valid
+    // memory.
+    void Rebuild(const std::vector<int>& order, std::vector<KeyFrame<T>> inserted) {
+        std::vector<KeyFrame<T>> rebuilt;
+        rebuilt.reserve(order.size());
+        for (int i : order) rebuilt.push_back(std::move(i >= 0 ? frames[i] : inserted[-1 - i]));
+
+        frames.resize(rebuilt.size());
+        std::move(rebuilt.begin(), rebuilt.end(), frames.begin());
+        MarkEdited();
+    }
 };
 
 
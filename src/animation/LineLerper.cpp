@@ -17,7 +17,40 @@ Vec2List LineLerper::Lerp(const Vec2List& vec1, const Vec2List& vec2, float t) {
     return vec;
 }
 
+Vec2List LineLerper::Lerp(const Correspondence& correspondence, float t) {
+    const size_t floatCount = correspondence.from.size();
+    if (floatCount == 0) return {};
+    Vec2List vec(floatCount / 2);
+
+    // plain loop over contiguous floats, vectorized by the compiler
+    float* out = &vec.data()->x;
+    const float* from = correspondence.from.data();
+    const float* delta = correspondence.delta.data();
+    for (size_t i = 0; i < floatCount; i++) {
+        out[i] = from[i] + delta[i] * t;
+    }
+
+    return vec;
+}
+
 std::vector<glm::vec2> LineLerper::MorphPolyLine(const std::vector<glm::vec2>& line1, const std::vector<glm::vec2>& line2, float t, int sampleCount) {
     return Lerp(Sampler::SampleTo(line1, sampleCount), Sampler::SampleTo(line2, sampleCount), t);
 }
 
+LineLerper::Correspondence LineLerper::Correspond(const std::vector<glm::vec2>& line1, const std::vector<glm::vec2>& line2, int sampleCount) {
+    const Vec2List sampled1 = Sampler::SampleTo(line1, sampleCount);
+    const Vec2List sampled2 = Sampler::SampleTo(line2, sampleCount);
+    const size_t count = std::min(sampled1.size(), sampled2.size());
+
+    Correspondence correspondence;
+    correspondence.from.reserve(count * 2);
+    correspondence.delta.reserve(count * 2);
+    for (size_t i = 0; i < count; i++) {
+        correspondence.from.push_back(sampled1[i].x);
+        correspondence.from.push_back(sampled1[i].y);
+        correspondence.delta.push_back(sampled2[i].x - sampled1[i].x);
+        correspondence.delta.push_back(sampled2[i].y - sampled1[i].y);
+    }
+    return correspondence;
+}
+
@@ -11,8 +11,16 @@
 
 class LineLerper {
 public:
+    // two lines resampled to the same point count, flattened to interleaved x, y so morphing is one lerp over floats
+    struct Correspondence {
+        std::vector<float> from;
+        std::vector<float> delta; // to - from
+    };
+
     static std::vector<glm::vec2> Lerp(const std::vector<glm::vec2>& vec1, const std::vector<glm::vec2>& vec2, float t);
+    static std::vector<glm::vec2> Lerp(const Correspondence& correspondence, float t);
     static std::vector<glm::vec2> MorphPolyLine(const std::vector<glm::vec2>& line1, const std::vector<glm::vec2>& line2, float t, int sampleCount);
+    static Correspondence Correspond(const std::vector<glm::vec2>& line1, const std::vector<glm::vec2>& line2, int sampleCount);
 };
 
 
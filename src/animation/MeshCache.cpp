@@ -0,0 +1,96 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "MeshCache.h"
+
+std::list<MeshCache::Entry> MeshCache::entries;
+std::unordered_map<MeshCache::Key, std::list<MeshCache::Entry>::iterator, MeshCache::KeyHash> MeshCache::lookup;
+size_t MeshCache::totalBytes = 0;
+size_t MeshCache::budgetBytes = 256 << 20;
+uint64_t MeshCache::hits = 0;
+uint64_t MeshCache::misses = 0;
+uint64_t MeshCache::evictions = 0;
+
+MeshCache::Key MeshCache::KeyFor(ModelObject& obj, float time) {
+	return {obj.GetID(), (int) std::lround(time * STEPS_PER_SECOND), obj.GetEditGeneration(), obj.GetAnimatorPtr()->GetRevision()};
+}
+
+MeshCache::Value MeshCache::Find(const Key& key) {
+	const auto it = lookup.find(key);
+	if (it == lookup.end()) {
+		misses++;
+		return nullptr;
+	}
+
+	hits++;
+	entries.splice(entries.begin(), entries, it->second); // most recently used
+	return it->second->value;
+}
+
+void MeshCache::Insert(const Key& key, Value value) {
+	const auto it = lookup.find(key);
+	if (it != lookup.end()) {
+		totalBytes -= it->second->bytes;
+		entries.erase(it->second);
+		lookup.erase(it);
+	}
+
+	const size_t bytes = ByteSize(*value);
+	entries.push_front({key, std::move(value), bytes});
+	lookup[key] = entries.begin();
+	totalBytes += bytes;
+
+	EvictToBudget();
+}
+
+void MeshCache::Clear() {
+	entries.clear();
+	lookup.clear();
+	totalBytes = 0;
+}
+
+void MeshCache::DebugGui() {
+	ImGui::Begin("Mesh Cache");
+
+	const uint64_t lookups = hits + misses;
+	ImGui::Text("hit rate: %.1f%% (%llu / %llu)", lookups == 0 ? 0.0f : 100.0f * (float) hits / (float) lookups,
+	            (unsigned long long) hits, (unsigned long long) lookups);
+	ImGui::Text("entries: %zu, evicted: %llu", entries.size(), (unsigned long long) evictions);
+	ImGui::Text("memory: %.1f / %.0f MB", (float) totalBytes / (float) (1 << 20), (float) budgetBytes / (float) (1 << 20));
+
+	int budgetMB = (int) (budgetBytes >> 20);
+	if (ImGui::SliderInt("budget (MB)", &budgetMB, 16, 2048)) {
+		budgetBytes = (size_t) budgetMB << 20;
+		EvictToBudget();
+	}
+
+	if (ImGui::Button("clear")) Clear();
+	ImGui::SameLine();
+	if (ImGui::Button("reset stats")) hits = misses = evictions = 0;
+
+	ImGui::End();
+}
+
+size_t MeshCache::KeyHash::operator()(const Key& key) const {
+	size_t hash = std::hash<int>()(key.objectID);
+	const auto Combine = [&](size_t value) { hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2); };
+	Combine(std::hash<int>()(key.timeStep));
+	Combine(std::hash<uint64_t>()(key.editGeneration));
+	Combine(std::hash<uint64_t>()(key.revision));
+	return hash;
+}
+
+size_t MeshCache::ByteSize(const ModelObject::GeneratedMesh& mesh) { // derived 2D state is small next to the mesh, not counted
+	return mesh.data.vertexData.size() * sizeof(GLfloat) + mesh.data.indices.size() * sizeof(GLuint) + sizeof(Entry);
+}
+
+void MeshCache::EvictToBudget() {
+	while (totalBytes > budgetBytes && !entries.empty()) {
+		const Entry& oldest = entries.back();
+		totalBytes -= oldest.bytes;
+		lookup.erase(oldest.key);
+		entries.pop_back();
+		evictions++;
+	}
+}
@@ -0,0 +1,63 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_MESHCACHE_H
+#define SENIORRESEARCH_MESHCACHE_H
+
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+#include "../generation/ModelObject.h"
+
+// LRU of meshes generated by timeline evaluation, so scrubbing or looping over the same span doesn't regenerate them.
+// Entries are keyed by object, time (quantized to STEPS_PER_SECOND) and everything that can change the result
+// (the object's edit generation and its keyframes' revision); stale entries are never hit and age out.
+// Only CPU-side data is kept, a hit still uploads. Main thread only.
+class MeshCache {
+public:
+	struct Key {
+		int objectID;
+		int timeStep;
+		uint64_t editGeneration;
+		uint64_t revision;
+
+		bool operator==(const Key& other) const = default;
+	};
+
+	using Value = std::shared_ptr<const ModelObject::GeneratedMesh>;
+
+	[[nodiscard]] static Key KeyFor(ModelObject& obj, float time);
+	[[nodiscard]] static Value Find(const Key& key); // null on a miss
+	static void Insert(const Key& key, Value value);
+	static void Clear();
+
+	static void DebugGui();
+
+	static constexpr float STEPS_PER_SECOND = 60.0f; // matches PlaybackScheduler::FRAME_RATE
+
+private:
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+
+	struct Entry {
+		Key key;
+		Value value;
+		size_t bytes;
+	};
+
+	static size_t ByteSize(const ModelObject::GeneratedMesh& mesh);
+	static void EvictToBudget();
+
+	static std::list<Entry> entries; // most recently used first
+	static std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+	static size_t totalBytes, budgetBytes;
+	static uint64_t hits, misses, evictions;
+};
+
+
+#endif //SENIORRESEARCH_MESHCACHE_H
@@ -0,0 +1,64 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "MorphCache.h"
+
+#include <algorithm>
+
+std::mutex MorphCache::mutex;
+std::list<MorphCache::Entry> MorphCache::entries;
+std::unordered_map<MorphCache::Key, std::list<MorphCache::Entry>::iterator, MorphCache::KeyHash> MorphCache::lookup;
+size_t MorphCache::totalBytes = 0;
+
+MorphCache::Value MorphCache::Get(const PackedPolyline& from, const PackedPolyline& to) {
+	const Key key = {from.GetContentID(), to.GetContentID()};
+	{
+		std::lock_guard lock(mutex);
+		const auto it = lookup.find(key);
+		if (it != lookup.end()) {
+			entries.splice(entries.begin(), entries, it->second); // most recently used
+			return it->second->value;
+		}
+	}
+
+	// built outside the lock, two threads missing on the same pair at once both build it and the first insert wins
+	const Vec2List line1 = from.Decode();
+	const Vec2List line2 = to.Decode();
+	// TODO: better count??
+	Value value = std::make_shared<const LineLerper::Correspondence>(
+			LineLerper::Correspond(line1, line2, (int) std::max(line1.size(), line2.size())));
+
+	std::lock_guard lock(mutex);
+	const auto it = lookup.find(key);
+	if (it != lookup.end()) return it->second->value;
+
+	const size_t bytes = (value->from.size() + value->delta.size()) * sizeof(float) + sizeof(Entry);
+	entries.push_front({key, value, bytes});
+	lookup[key] = entries.begin();
+	totalBytes += bytes;
+	EvictToBudget();
+	return value;
+}
+
+void MorphCache::Clear() {
+	std::lock_guard lock(mutex);
+	entries.clear();
+	lookup.clear();
+	totalBytes = 0;
+}
+
+size_t MorphCache::KeyHash::operator()(const Key& key) const {
+	size_t hash = std::hash<uint64_t>()(key.from);
+	hash ^= std::hash<uint64_t>()(key.to) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+void MorphCache::EvictToBudget() { // evicted values stay alive for whoever is still lerping with them
+	while (totalBytes > BUDGET_BYTES && !entries.empty()) {
+		const Entry& oldest = entries.back();
+		totalBytes -= oldest.bytes;
+		lookup.erase(oldest.key);
+		entries.pop_back();
+	}
+}
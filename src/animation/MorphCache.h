@@ -0,0 +1,57 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_MORPHCACHE_H
+#define SENIORRESEARCH_MORPHCACHE_H
+
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include "LineLerper.h"
+#include "../util/PackedPolyline.h"
+
+// LRU of stroke morph correspondences (LineLerper::Correspond), keyed by the content IDs of the two keyframed strokes.
+// Entries are built the first time something evaluates between the two frames, so only pairs that are actually played
+// or scrubbed over take memory. Copies of a layer (worker copies during playback) keep their strokes' IDs and so share
+// entries, while an edited stroke gets a new ID: its old entries are never hit again and age out under the budget.
+// Any thread.
+class MorphCache {
+public:
+	using Value = std::shared_ptr<const LineLerper::Correspondence>;
+
+	[[nodiscard]] static Value Get(const PackedPolyline& from, const PackedPolyline& to);
+	static void Clear();
+
+	static constexpr size_t BUDGET_BYTES = 32 << 20;
+
+private:
+	struct Key {
+		uint64_t from, to;
+
+		bool operator==(const Key& other) const = default;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+
+	struct Entry {
+		Key key;
+		Value value;
+		size_t bytes;
+	};
+
+	static void EvictToBudget(); // with mutex held
+
+	static std::mutex mutex;
+	static std::list<Entry> entries; // most recently used first
+	static std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup;
+	static size_t totalBytes;
+};
+
+
+#endif //SENIORRESEARCH_MORPHCACHE_H
@@ -0,0 +1,244 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "PlaybackScheduler.h"
+#include "Timeline.h"
+#include "MeshCache.h"
+#include "../generation/ModelObject.h"
+#include "../util/ThreadPool.h"
+
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+
+// objects as they were when playback (re)started, read-only once frames are dispatched
+struct PlaybackScheduler::Snapshot {
+	struct Entry {
+		ModelObject* live;
+		std::unique_ptr<ModelObject> source; // copy that evaluation copies are cloned from
+	};
+	using CopySet = std::vector<std::unique_ptr<ModelObject>>; // one evaluation copy per entry
+
+	std::vector<ModelObject*> objects; // everything handed to Present, animated or not
+	std::vector<uint64_t> editGenerations, revisions; // per object, for IsCurrent
+	std::vector<Entry> entries; // animated objects only
+
+	// evaluation copies are recycled between frames instead of re-cloned for every frame
+	CopySet Acquire() {
+		{
+			std::lock_guard lock(mutex);
+			if (!freeCopies.empty()) {
+				CopySet copies = std::move(freeCopies.back());
+				freeCopies.pop_back();
+				return copies;
+			}
+		}
+		CopySet copies;
+		for (const Entry& entry : entries) copies.emplace_back(entry.source->Clone());
+		return copies;
+	}
+
+	void Release(CopySet copies) {
+		std::lock_guard lock(mutex);
+		freeCopies.push_back(std::move(copies));
+	}
+
+private:
+	std::mutex mutex;
+	std::vector<CopySet> freeCopies;
+};
+
+struct PlaybackScheduler::Frame {
+	int index;
+	int direction; // of the path when it was queued, ping-pong bounces flip it
+	float time;
+	bool presented = false; // main thread only
+	std::shared_ptr<Snapshot> snapshot;
+
+	std::atomic<bool> ready = false, cancelled = false;
+	std::vector<MeshCache::Value> meshes; // parallel to snapshot->entries, written by the worker until ready
+};
+
+bool PlaybackScheduler::Present(const std::vector<ModelObject*>& objects, const Playhead& playhead) {
+	if (!IsCurrent(objects)) Start(objects, playhead);
+	if (snapshot->entries.empty()) return false; // nothing animated
+
+	const int index = FrameIndex(playhead.time);
+	const int direction = Direction(playhead);
+	stride = Stride(playhead); // a new speed or frame time only changes how the tail continues
+
+	// last queued frame at or behind the playhead
+	int position = -1;
+	for (int i = 0; i < queue.size(); i++) {
+		if (Ahead(*queue[i], index, direction) <= 0) position = i;
+	}
+
+	const bool outsideSpan = !FollowsPath(playhead) || position == -1 // behind the oldest queued frame
+			|| -Ahead(*queue.back(), index, direction) > LOOKAHEAD * stride; // far past the newest one
+	if (outsideSpan) { // scrubbed, reversed, or the loop changed
+		RestartAt(index, playhead);
+		return false;
+	}
+
+	// newest finished frame at or behind the playhead stays at the front until a newer one is ready,
+	// everything older is dropped; with nothing finished yet, only the frame nearest the playhead is waited on
+	int keepFrom = position;
+	for (int i = position; i >= 0; i--) {
+		if (queue[i]->ready) {
+			keepFrom = i;
+			break;
+		}
+	}
+	for (int i = 0; i < keepFrom; i++) {
+		queue.front()->cancelled = true;
+		queue.pop_front();
+	}
+
+	if (Ahead(*queue.back(), index, direction) <= 0) { // ran past the queued frames, continue from the playhead
+		tailIndex = index;
+		tailDirection = direction;
+	}
+
+	Frame& front = *queue.front();
+	const bool present = front.ready && !front.presented;
+	if (present) {
+		Adopt(front);
+		front.presented = true;
+	}
+	Fill();
+	return present;
+}
+
+void PlaybackScheduler::Stop() {
+	for (auto& frame : queue) frame->cancelled = true; // running tasks finish into frames nobody reads
+	queue.clear();
+	snapshot.reset();
+}
+
+void PlaybackScheduler::Start(const std::vector<ModelObject*>& objects, const Playhead& playhead) {
+	Stop();
+
+	snapshot = std::make_shared<Snapshot>();
+	snapshot->objects = objects;
+	for (ModelObject* obj : objects) {
+		Animator& objAnimator = *obj->GetAnimatorPtr();
+		snapshot->editGenerations.push_back(obj->GetEditGeneration());
+		snapshot->revisions.push_back(objAnimator.GetRevision());
+
+		if (!objAnimator.HasKeyFrames()) continue;
+		snapshot->entries.push_back({obj, std::unique_ptr<ModelObject>(obj->Clone())});
+	}
+
+	RestartAt(FrameIndex(playhead.time), playhead);
+}
+
+bool PlaybackScheduler::IsCurrent(const std::vector<ModelObject*>& objects) const {
+	if (!snapshot || snapshot->objects != objects) return false;
+
+	for (int i = 0; i < objects.size(); i++) {
+		if (objects[i]->GetEditGeneration() != snapshot->editGenerations[i]) return false;
+		if (objects[i]->GetAnimatorPtr()->GetRevision() != snapshot->revisions[i]) return false;
+	}
+	return true;
+}
+
+void PlaybackScheduler::RestartAt(int frameIndex, const Playhead& playhead) {
+	for (auto& frame : queue) frame->cancelled = true;
+	queue.clear();
+
+	pingPong = playhead.pingPong;
+	endIndex = std::max(0, FrameIndex(playhead.endTime));
+	stride = Stride(playhead);
+	tailDirection = Direction(playhead);
+	tailIndex = frameIndex - tailDirection * stride; // so Fill queues frameIndex first
+
+	Fill();
+}
+
+bool PlaybackScheduler::FollowsPath(const Playhead& playhead) const {
+	if (queue.empty() || playhead.pingPong != pingPong || std::max(0, FrameIndex(playhead.endTime)) != endIndex) return false;
+	return pingPong || Direction(playhead) == tailDirection; // a looping path only runs one way
+}
+
+int PlaybackScheduler::PathPosition(int frameIndex, int direction) const { // the path is a cycle, see Fill
+	if (pingPong) return (direction > 0) ? frameIndex : 2 * endIndex - frameIndex;
+	return (direction > 0) ? frameIndex : endIndex - frameIndex;
+}
+
+int PlaybackScheduler::Ahead(const Frame& frame, int frameIndex, int direction) const {
+	const int length = pingPong ? std::max(1, 2 * endIndex) : endIndex + 1;
+	int ahead = (PathPosition(frame.index, frame.direction) - PathPosition(frameIndex, direction)) % length;
+	if (ahead < 0) ahead += length;
+	return (ahead > length / 2) ? ahead - length : ahead; // the nearer way round
+}
+
+void PlaybackScheduler::Fill() {
+	if (!snapshot || snapshot->entries.empty()) return;
+
+	while (queue.size() < LOOKAHEAD) {
+		// mirrors the wrap-around / ping-pong in Timeline::Update
+		int next = tailIndex + tailDirection * stride;
+		if (next > endIndex) {
+			if (pingPong) {
+				next = endIndex;
+				tailDirection = -1;
+			} else next = 0;
+		} else if (next < 0) {
+			if (pingPong) {
+				next = 0;
+				tailDirection = 1;
+			} else next = endIndex;
+		}
+		tailIndex = next;
+
+		auto frame = std::make_shared<Frame>();
+		frame->index = next;
+		frame->direction = tailDirection;
+		frame->time = (float) next / FRAME_RATE;
+		frame->snapshot = snapshot;
+		queue.push_back(frame);
+
+		// already generated on an earlier pass over this span (looping, ping-pong), no need to go to the pool
+		for (const auto& entry : snapshot->entries) {
+			MeshCache::Value mesh = MeshCache::Find(MeshCache::KeyFor(*entry.live, frame->time));
+			if (!mesh) break;
+			frame->meshes.push_back(std::move(mesh));
+		}
+		if (frame->meshes.size() == snapshot->entries.size()) frame->ready = true;
+		else {
+			frame->meshes.clear();
+			Dispatch(frame);
+		}
+	}
+}
+
+void PlaybackScheduler::Dispatch(const std::shared_ptr<Frame>& frame) {
+	ThreadPool::Shared().Submit([frame] {
+		if (frame->cancelled) return;
+
+		Snapshot::CopySet copies = frame->snapshot->Acquire();
+		std::vector<MeshCache::Value> meshes;
+		for (const auto& copy : copies) {
+			if (frame->cancelled) break;
+			Timeline::EvaluateAtTime(*copy, frame->time);
+			meshes.push_back(std::make_shared<const ModelObject::GeneratedMesh>(copy->GenerateMesh()));
+		}
+		frame->snapshot->Release(std::move(copies));
+		if (meshes.size() != frame->snapshot->entries.size()) return; // cancelled part way
+
+		frame->meshes = std::move(meshes);
+		frame->ready = true;
+	});
+}
+
+void PlaybackScheduler::Adopt(Frame& frame) {
+	const auto& entries = frame.snapshot->entries;
+	for (size_t i = 0; i < entries.size(); i++) {
+		ModelObject& live = *entries[i].live;
+		Timeline::EvaluateAtTime(live, frame.time); // just the points / values, cheap, the workers already built the morphs
+		live.ApplyGeneratedMesh(*frame.meshes[i]);
+		MeshCache::Insert(MeshCache::KeyFor(live, frame.time), frame.meshes[i]);
+		live.GetAnimatorPtr()->MarkEvaluatedAt(frame.time);
+	}
+}
@@ -0,0 +1,80 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_PLAYBACKSCHEDULER_H
+#define SENIORRESEARCH_PLAYBACKSCHEDULER_H
+
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+class ModelObject;
+
+// Timeline playback without remeshing on the UI thread:
+//  - playback time is quantized to FRAME_RATE, and the next LOOKAHEAD frames along the playhead's path
+//    (speed, direction, wrap-around / ping-pong) are evaluated and meshed on the shared thread pool
+//  - each worker task evaluates copies of the animated objects, taken when playback (re)starts; frames already in
+//    the MeshCache (a second pass over a loop) are ready without going to the pool
+//  - the UI thread only uploads the newest finished frame at or behind the playhead, and keeps it queued until a newer
+//    one is ready; if the workers fall behind, unfinished frames are skipped and the last presented frame stays on screen
+// Editing an object or its keyframes, or the playhead leaving the queued span (a scrub, a reversal), restarts the
+// look-ahead from the current frame. Jitter and speed changes inside the span only change how the tail continues.
+class PlaybackScheduler {
+public:
+	struct Playhead { // Timeline playback state
+		float time;
+		float speed;
+		float deltaTime;
+		bool pingPong;
+		float endTime;
+	};
+
+	PlaybackScheduler() = default;
+	PlaybackScheduler(const PlaybackScheduler&) = delete;
+	~PlaybackScheduler() { Stop(); }
+
+	// main thread, once per frame while playing -- true if a frame was uploaded
+	bool Present(const std::vector<ModelObject*>& objects, const Playhead& playhead);
+	void Stop();
+
+	[[nodiscard]] bool IsRunning() const { return snapshot != nullptr; }
+
+	static constexpr float FRAME_RATE = 60.0f;
+	static constexpr int LOOKAHEAD = 8;
+
+private:
+	struct Snapshot;
+	struct Frame;
+
+	void Start(const std::vector<ModelObject*>& objects, const Playhead& playhead);
+	[[nodiscard]] bool IsCurrent(const std::vector<ModelObject*>& objects) const;
+	void RestartAt(int frameIndex, const Playhead& playhead);
+	[[nodiscard]] bool FollowsPath(const Playhead& playhead) const; // same loop mode, length and (looping) direction
+	[[nodiscard]] int PathPosition(int frameIndex, int direction) const;
+	[[nodiscard]] int Ahead(const Frame& frame, int frameIndex, int direction) const; // signed, along the path
+	void Fill();
+	void Dispatch(const std::shared_ptr<Frame>& frame);
+	void Adopt(Frame& frame);
+
+	[[nodiscard]] static int FrameIndex(float time) { return (int) std::lround(time * FRAME_RATE); }
+	[[nodiscard]] static int Direction(const Playhead& playhead) { return (playhead.speed < 0.0f) ? -1 : 1; }
+	// frames the playhead advances per UI frame, so faster playback or a slower UI doesn't prefetch skipped frames
+	[[nodiscard]] static int Stride(const Playhead& playhead) {
+		return std::max(1, (int) std::lround(std::abs(playhead.speed) * playhead.deltaTime * FRAME_RATE));
+	}
+
+	std::shared_ptr<Snapshot> snapshot;
+	std::deque<std::shared_ptr<Frame>> queue; // upcoming frames in playback order, front is the oldest
+
+	// path of the last queued frame, continued by Fill
+	int tailIndex = 0, tailDirection = 1, stride = 1, endIndex = 0;
+	bool pingPong = false;
+};
+
+
+#endif //SENIORRESEARCH_PLAYBACKSCHEDULER_H
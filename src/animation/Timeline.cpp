@@ -8,8 +8,12 @@
 #include "blending/SineBlendMode.h"
 #include "blending/PiecewiseBlendMode.h"
 #include "Animator.h"
+#include "MeshCache.h"
+#include "../util/ThreadPool.h"
 #include "../util/Controls.h"
 #include "../program/Program.h"
+#include "../util/Profiler.h"
+#include "../util/TraceRecorder.h"
 
 std::vector<int> numKeys = {
     GLFW_KEY_1, GLFW_KEY_2, GLFW_KEY_3,
@@ -18,7 +22,7 @@ std::vector<int> numKeys = {
 };
 
 void Timeline::Update(const TimelineUpdateInfo& info) {
-
+	PROFILE_SCOPE("Timeline::Update");
 
 	const auto&[input, deltaTime, drawMode, modelObject, modelObjects, focusMode] = info;
 
@@ -28,44 +32,13 @@ void Timeline::Update(const TimelineUpdateInfo& info) {
 
 	scrollBar.Update(currentTime);
 
-	const auto SampleAtTime = [](ModelObject& obj, float time) {
-        bool diffFlag = false;
-
-        auto& keyFrameLayers = obj.GetAnimatorPtr()->keyFrameLayers;
-        auto& floatKeyFrameLayers = obj.GetAnimatorPtr()->floatKeyFrameLayers;
-
-        for (auto& [mode, keyFrameLayer] : keyFrameLayers) {
-            if (keyFrameLayer.HasValue()) {
-                Vec2List& pointsRef = obj.GetPointsRefByMode(mode);
-
-                auto animatedPoints = keyFrameLayer.GetAnimatedVal(time);
-                pointsRef.clear();
-                pointsRef.insert(pointsRef.end(), animatedPoints.begin(), animatedPoints.end());
-                diffFlag = true;
-            }
-        }
-
-        for (auto& [valLabel, settableKeyFrameLayer] : floatKeyFrameLayers) {
-            if (settableKeyFrameLayer.layer.HasValue()) {
-                obj.SetValueByLabel(valLabel, settableKeyFrameLayer.layer.GetAnimatedVal(time));
-                diffFlag = true;
-            }
-        }
-
-        if (diffFlag) {
-            obj.UpdateMesh();
-        }
+    const auto AnimatedObjects = [&] { // everything the timeline evaluates: just the focused object in focus mode
+        if (info.focusMode) return std::vector<ModelObject*>{&info.modelObject};
+        return Linq::Select<std::shared_ptr<ModelObject>, ModelObject*>(info.modelObjects, [](std::shared_ptr<ModelObject> obj) { return obj.get(); });
     };
 
     const auto SampleAllAtTime = [&](float time) {
-        if (info.focusMode) {
-            SampleAtTime(info.modelObject, time);
-            return;
-        }
-
-        for (const auto& obj : info.modelObjects) {
-            SampleAtTime(*obj, time);
-        }
+        SampleObjectsAtTime(AnimatedObjects(), time);
     };
 
     // mouse pos ===
@@ -143,9 +116,11 @@ void Timeline::Update(const TimelineUpdateInfo& info) {
             // dragging
             if (dragging) {
                 const float dragDiff = (mousePos.x - selectDragStart.x) * 0.5f * scrollBar.GenView().GetSpannedTime();
-                selection.MoveAllRounded(-lastDragDiff);
-                selection.MoveAllRounded(dragDiff);
-                lastDragDiff = dragDiff;
+                if (RoundToTenth(dragDiff) != RoundToTenth(lastDragDiff)) { // moves snap to tenths, most mouse motion moves nothing
+                    selection.MoveAllRounded(-lastDragDiff);
+                    selection.MoveAllRounded(dragDiff);
+                    lastDragDiff = dragDiff;
+                }
             }
 
             // Time-picker ===
@@ -173,15 +148,23 @@ void Timeline::Update(const TimelineUpdateInfo& info) {
         if (input.Pressed(GLFW_KEY_SPACE)) playing ^= true;
     }
 
+    if (!playing && playbackScheduler.IsRunning()) { // show the exact paused time, not the last pre-generated frame
+        playbackScheduler.Stop();
+        SampleAllAtTime(animator->currentTime);
+    }
+
     if (!playing) {
         // auto-keying points
         {
             for (const auto mode : {Enums::MODE_PLOT, Enums::MODE_GRAPH_Y, Enums::MODE_GRAPH_Z, Enums::MODE_CROSS_SECTION}) {
                 if (modelObject.HasDiff(mode)) {
                     if (!modelObject.GetPointsRefByMode(mode).empty()) {
-                        keyFrameLayers[mode].Insert({modelObject.GetPointsRefByMode(mode), currentTime});
+                        const KeyFrame<PackedPolyline> frame = {modelObject.GetPointsRefByMode(mode), currentTime};
+                        keyFrameLayers[mode].Insert(frame);
+                        Journal::RecordKeyFrame(modelObject.GetID(), mode, frame);
                     } else {
                         keyFrameLayers[mode].RemoveAtTime(currentTime);
+                        Journal::RecordRemove(modelObject.GetID(), Journal::LayerKey::Points(mode), currentTime);
                     }
                 }
             }
@@ -199,9 +182,10 @@ void Timeline::Update(const TimelineUpdateInfo& info) {
                 const Vec2List pointsRef = modelObject.GetPointsRefByMode(drawMode);
 
                 if (pointsRef.size() >= 2) {
-                    KeyFrame<Vec2List> frame = {pointsRef, currentTime};
+                    KeyFrame<PackedPolyline> frame = {pointsRef, currentTime};
                     frame.blendModeID = 2;
                     keyFrameLayers[drawMode].Insert(frame);
+                    Journal::RecordKeyFrame(modelObject.GetID(), drawMode, frame);
                 }
             }
 
@@ -209,13 +193,17 @@ void Timeline::Update(const TimelineUpdateInfo& info) {
                 if (input.Down(GLFW_KEY_LEFT_SHIFT)) {
                     for (auto& [mode, keyFrameLayer] : keyFrameLayers) {
                         keyFrameLayers[mode].RemoveAtTime(currentTime);
+                        Journal::RecordRemove(modelObject.GetID(), Journal::LayerKey::Points(mode), currentTime);
                     }
 
-                    for (auto& [valLabel, keyFrameLayer] : floatKeyFrameLayers) {
-                        floatKeyFrameLayers[valLabel].layer.RemoveAtTime(currentTime);
+                    for (int param = 0; param < Enums::PARAM_COUNT; param++) {
+                        if (!floatKeyFrameLayers[param]) continue;
+                        floatKeyFrameLayers[param]->RemoveAtTime(currentTime);
+                        Journal::RecordRemove(modelObject.GetID(), Journal::LayerKey::Float((Enums::AnimatableParam) param), currentTime);
                     }
                 } else {
                     keyFrameLayers[drawMode].RemoveAtTime(currentTime);
+                    Journal::RecordRemove(modelObject.GetID(), Journal::LayerKey::Points(drawMode), currentTime);
                 }
             }
         }
@@ -237,12 +225,74 @@ void Timeline::Update(const TimelineUpdateInfo& info) {
             else animator->currentTime = scrollBar.maxScrollArea;
         }
 
-        SampleAllAtTime(currentTime);
+        playbackScheduler.Present(AnimatedObjects(), {animator->currentTime, playbackSpeed, deltaTime, pingPong, scrollBar.maxScrollArea});
     }
 
     lastFocused = focused;
 }
 
+void Timeline::SampleObjectsAtTime(const std::vector<ModelObject*>& objects, float time) {
+    struct Sample {
+        ModelObject* obj;
+        MeshCache::Key key;
+        MeshCache::Value mesh; // cached, or generated by the task
+        bool cached;
+        bool evaluated = false;
+    };
+
+    // cache lookups on this thread (the cache is main-thread only), the key doesn't depend on the evaluation
+    std::vector<Sample> samples;
+    for (ModelObject* obj : objects) {
+        Animator& objAnimator = *obj->GetAnimatorPtr();
+        if (objAnimator.IsEvaluatedAt(time) || !objAnimator.HasKeyFrames()) continue;
+        objAnimator.MarkEvaluatedAt(time);
+
+        const MeshCache::Key key = MeshCache::KeyFor(*obj, time);
+        MeshCache::Value mesh = MeshCache::Find(key);
+        const bool cached = mesh != nullptr;
+        samples.push_back({obj, key, std::move(mesh), cached});
+    }
+
+    // objects only write their own points, values and mesh data, so each is an independent task
+    ThreadPool::Shared().ParallelFor(samples.size(), [&](size_t i) {
+        Sample& sample = samples[i];
+        sample.evaluated = EvaluateAtTime(*sample.obj, time);
+        if (sample.evaluated && !sample.mesh) sample.mesh = std::make_shared<const ModelObject::GeneratedMesh>(sample.obj->GenerateMesh());
+    });
+
+    // GL uploads
+    for (Sample& sample : samples) {
+        if (!sample.evaluated) continue;
+        if (!sample.cached) MeshCache::Insert(sample.key, sample.mesh);
+        sample.obj->ApplyGeneratedMesh(*sample.mesh);
+    }
+}
+
+bool Timeline::EvaluateAtTime(ModelObject& obj, float time) {
+    TRACE_SCOPE("Timeline::EvaluateAtTime");
+    bool diffFlag = false;
+
+    auto& keyFrameLayers = obj.GetAnimatorPtr()->keyFrameLayers;
+    auto& floatKeyFrameLayers = obj.GetAnimatorPtr()->floatKeyFrameLayers;
+
+    for (auto& [mode, keyFrameLayer] : keyFrameLayers) {
+        if (keyFrameLayer.HasValue()) {
+            obj.GetPointsRefByMode(mode) = keyFrameLayer.GetAnimatedVal(time);
+            diffFlag = true;
+        }
+    }
+
+    for (int param = 0; param < Enums::PARAM_COUNT; param++) {
+        auto& floatKeyFrameLayer = floatKeyFrameLayers[param];
+        if (floatKeyFrameLayer && floatKeyFrameLayer->HasValue()) {
+            obj.SetValue((Enums::AnimatableParam) param, floatKeyFrameLayer->GetAnimatedVal(time));
+            diffFlag = true;
+        }
+    }
+
+    return diffFlag;
+}
+
 float Timeline::TimeToX(float time) const {
 	const auto& span = scrollBar.GenView();
 
@@ -291,11 +341,15 @@ void Timeline::Render(const TimelineRenderInfo& info) {
     }
 
     int floatLayerInc = 0;
-    for (auto& [label, keyFrameLayer] : floatKeyFrameLayers) {
-        keyFrameLayer.layer.Render(canvas, 4 + floatLayerInc, currentTime, minVisibleTime, maxVisibleTime, [&](float time){ return TimeToX(time); }, ContainsFunc);
+    for (auto& keyFrameLayer : floatKeyFrameLayers) {
+        if (!keyFrameLayer) continue;
+        keyFrameLayer->Render(canvas, 4 + floatLayerInc, currentTime, minVisibleTime, maxVisibleTime, [&](float time){ return TimeToX(time); }, ContainsFunc);
         floatLayerInc++;
     }
 
+    canvas.ImmediateClearingRender(Util::Identity());
+
+    // overlays, in their own pass so the selection rectangle covers the keyframe lines
     if (selecting) {
         canvas.AddQuad(selectDragStart, selectDragEnd, Util::RGBA(200, 200, 255, 40));
     }
@@ -307,7 +361,7 @@ void Timeline::Render(const TimelineRenderInfo& info) {
         canvas.AddLines({{mousePos.x, 1.0f - selectAreaSize}, {mousePos.x, 1.0f}}, RGBA(0.8f, 0.8f, 1.0f, 0.3f), 0.003f);
     }
 
-    canvas.ImmediateClearingRender();
+    canvas.ImmediateClearingRender(Util::Identity());
     shader2D.Disable();
     RenderTarget::Unbind();
 
@@ -315,6 +369,14 @@ void Timeline::Render(const TimelineRenderInfo& info) {
 	scrollBar.Render(canvas, shader2D);
 }
 
+Rectangle Timeline::GetGuiRect() const {
+	const Rectangle& bar = scrollBar.guiRect;
+	const float left = std::min(guiRect.x, bar.x), top = std::min(guiRect.y, bar.y);
+	const float right = std::max(guiRect.x + guiRect.width, bar.x + bar.width);
+	const float bottom = std::max(guiRect.y + guiRect.height, bar.y + bar.height);
+	return {left, top, right - left, bottom - top};
+}
+
 void Timeline::Gui() {
 	const Input& input = Program::GetInput();
     bool mouseOnGUI = Util::VecIsNormalizedNP(Util::NormalizeToRectNPFlipped(input.GetMouse(), guiRect));
@@ -329,6 +391,12 @@ void Timeline::Gui() {
     ImGui::Checkbox("rep", &pingPong);
     ImGui::SameLine();
 
+    int& frameCap = Program::GetFrameScheduler().frameCap;
+    ImGui::SetNextItemWidth(70.0f);
+    ImGui::DragInt("##playback-frame-cap", &frameCap, 1.0f, 0, 240, frameCap == 0 ? "uncapped" : "%d fps");
+    if (ImGuiHelper::HoverDelayTooltip()) ImGui::SetTooltip("%s", "playback frame cap");
+    ImGui::SameLine();
+
     ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - 8.0f);
     ImGui::SliderFloat("##playback-speed", &playbackSpeed, -5.0f, 5.0f);
     if (ImGuiHelper::HoverDelayTooltip()) ImGui::SetTooltip("%s", "playback-speed");
@@ -386,8 +454,8 @@ void Timeline::RenderOnionSkin(Mesh2D& plot, Enums::DrawMode drawMode) {
     const auto back = keyFrameLayers[drawMode].KeyFrameBelow(currentTime);
     const auto forward = keyFrameLayers[drawMode].KeyFrameAbove(currentTime);
 
-    if (back.has_value()) plot.AddLines(back.value()->val, Util::RGB(255, 185, 185));
-    if (forward.has_value()) plot.AddLines(forward.value()->val, Util::RGB(197, 255, 175));
+    if (back.has_value()) plot.AddLines(back.value()->val.Decode(), Util::RGB(255, 185, 185));
+    if (forward.has_value()) plot.AddLines(forward.value()->val.Decode(), Util::RGB(197, 255, 175));
 }
 
 TimelineSelection Timeline::GenTimelineSelection() {
@@ -395,6 +463,7 @@ TimelineSelection Timeline::GenTimelineSelection() {
     auto& floatKeyFrameLayers = animator->floatKeyFrameLayers;
 
     TimelineSelection newSelection;
+    newSelection.objectID = ActiveObjectID();
 
     const float minTime = XToTime(std::min(selectDragStart.x, selectDragEnd.x));
     const float maxTime = XToTime(std::max(selectDragStart.x, selectDragEnd.x));
@@ -413,29 +482,32 @@ TimelineSelection Timeline::GenTimelineSelection() {
 
     // TODO: generalize
     for (auto& [mode, keyFrameLayer] : keyFrameLayers) {
-        std::vector<KeyFrame<Vec2List>*> keyFramePtrs;
-        for (KeyFrame<Vec2List>& val : keyFrameLayer.frames) {
+        std::vector<KeyFrame<PackedPolyline>*> keyFramePtrs;
+        for (KeyFrame<PackedPolyline>& val : keyFrameLayer.frames) {
             if (InRange(val.time, 3 - i)) {
                 keyFramePtrs.emplace_back(&val);
             }
         }
 
         if (!keyFramePtrs.empty()) {
-            newSelection.rowSelections.emplace_back(KeyFrameRowSelection<Vec2List>{&keyFrameLayer, keyFramePtrs, i});
+            newSelection.rowSelections.emplace_back(KeyFrameRowSelection<PackedPolyline>{&keyFrameLayer, keyFramePtrs, i, Journal::LayerKey::Points(mode)});
         }
         i++;
     }
 
-    for (auto& [valLabel, keyFrameLayer] : floatKeyFrameLayers) {
+    for (int param = 0; param < Enums::PARAM_COUNT; param++) {
+        auto& keyFrameLayer = floatKeyFrameLayers[param];
+        if (!keyFrameLayer) continue;
+
         std::vector<KeyFrame<float>*> keyFramePtrs;
-        for (KeyFrame<float>& val : keyFrameLayer.layer.frames) {
+        for (KeyFrame<float>& val : keyFrameLayer->frames) {
             if (InRange(val.time, i)) {
                 keyFramePtrs.emplace_back(&val);
             }
         }
 
         if (!keyFramePtrs.empty()) {
-            newSelection.rowSelections.emplace_back(KeyFrameRowSelection<float>{&keyFrameLayer.layer, keyFramePtrs, i});
+            newSelection.rowSelections.emplace_back(KeyFrameRowSelection<float>{&*keyFrameLayer, keyFramePtrs, i, Journal::LayerKey::Float((Enums::AnimatableParam) param)});
         }
         i++;
     }
@@ -456,3 +528,7 @@ float Timeline::XToTime(float xNP) const {
 	const auto& span = scrollBar.GenView();
 	return span.startTime + Util::RemapNPTo01(xNP) * span.GetSpannedTime();
 }
+
+int Timeline::ActiveObjectID() {
+	return Program::GetProject().GetCurrentModelObject()->GetID();
+}
@@ -15,6 +15,8 @@
 #include "KeyFrameLayer.h"
 #include "Animator.h"
 #include "TimelineScrollBar.h"
+#include "PlaybackScheduler.h"
+#include "../misc/Journal.h"
 #include <vector>
 #include <unordered_map>
 #include <variant>
@@ -30,6 +32,7 @@ struct KeyFrameRowSelection {
     KeyFrameLayer<T>* layer;
     std::vector<KeyFrame<T>*> frames;
     int index;
+    Journal::LayerKey layerKey;
 
     bool HasKeyFrameAtTime(float time) {
         for (auto* keyFrame : frames) {
@@ -38,13 +41,20 @@ struct KeyFrameRowSelection {
         }
         return false;
     }
+
+    [[nodiscard]] std::vector<float> Times() const {
+        std::vector<float> times;
+        for (auto* keyFrame : frames) times.push_back(keyFrame->time);
+        return times;
+    }
 };
 
 struct TimelineSelection {
 #define TIMELINE_SELECTION_HANDLE_BOTH(a) HandleAll(a, a)
 #define TIMELINE_SELECTION_HANDLE_BOTH_CAPTURE(a) HandleAllCapture(a, a)
 
-    std::vector<std::variant<KeyFrameRowSelection<Vec2List>, KeyFrameRowSelection<float>>> rowSelections;
+    std::vector<std::variant<KeyFrameRowSelection<PackedPolyline>, KeyFrameRowSelection<float>>> rowSelections;
+    int objectID = -1; // owner of the selected layers, for journaling
 
     [[nodiscard]] bool CrossCompare(const TimelineSelection& other) const {
         bool returnVal = false;
@@ -64,23 +74,22 @@ struct TimelineSelection {
     }
 
     void DeleteAll() const { 
-        const auto DeleteFunc = [](const auto& val) {
+        const auto DeleteFunc = [this](const auto& val) {
             for (int i = val.frames.size() - 1; i >= 0; i--) {
-                val.layer->RemoveAtTime((val.frames[i]->time));
+                Journal::RecordRemove(objectID, val.layerKey, val.frames[i]->time);
             }
+            val.layer->RemoveAll(val.Times());
         };
 
-        TIMELINE_SELECTION_HANDLE_BOTH(DeleteFunc);
+        TIMELINE_SELECTION_HANDLE_BOTH_CAPTURE(DeleteFunc);
     }
 
-    void MoveAll(float amount) const {
-        const auto MoveFunc = [amount](const auto& val) {
-            for (int i = 0; i < val.frames.size(); i++) {
-                val.layer->MoveFromTimeToTime(val.frames[i]->time, (val.frames[i]->time) + amount);
-            }
+    void MoveAll(float amount) {
+        const auto MoveFunc = [amount](auto& val) {
+            val.frames = val.layer->MoveAll(val.Times(), amount);
         };
 
-        TIMELINE_SELECTION_HANDLE_BOTH_CAPTURE(MoveFunc);
+        HandleAllMutable(MoveFunc, MoveFunc);
     }
 
     [[nodiscard]] int CountAll() const {
@@ -96,26 +105,14 @@ struct TimelineSelection {
     	
     	float roundAmount = std::round((amount) * 10.0f) / 10.0f;
 
-        const auto MoveFunc = [roundAmount](const auto& val) {
-//			auto framesCopy = val.frames;
-//
-			if (roundAmount > 0.0f) {
-				for (int i = val.frames.size() - 1; i >= 0; i--) {
-					auto* keyFramePtr = val.frames[i];
-					const float time = keyFramePtr->time;
-					const float newTime = time + roundAmount;
-					val.layer->MoveFromTimeToTime(time, newTime);
-				}
-			} else if (roundAmount < 0.0f) {
-				for (auto* keyFramePtr : val.frames) {
-					const float time = keyFramePtr->time;
-					const float newTime = time + roundAmount;
-					val.layer->MoveFromTimeToTime(time, newTime);
-				}
-			}
+        const auto MoveFunc = [this, roundAmount](auto& val) {
+			if (roundAmount == 0.0f) return;
+			val.frames = val.layer->MoveAll(val.Times(), roundAmount, [&](float time, float newTime) {
+				Journal::RecordMove(objectID, val.layerKey, time, newTime); // overlapping moves abort, and aren't recorded
+			});
         };
 
-        TIMELINE_SELECTION_HANDLE_BOTH_CAPTURE(MoveFunc);
+        HandleAllMutable(MoveFunc, MoveFunc);
 
         return true;
     }
@@ -133,14 +130,13 @@ struct TimelineSelection {
 
 
 	    const auto CopyFunc = [minTime, min](const auto& val) {
+		    decltype(val.layer->frames) frameCopies;
 		    for (auto* keyFramePtr : val.frames) {
 			    const float time = keyFramePtr->time;
-			    const float newTime = std::round((time - min + minTime) * 10.0f) / 10.0f;
-			    auto frameCopy = *keyFramePtr;
-			    frameCopy.time = newTime;
-			    if (val.layer->HasKeyFrameAtTime(newTime)) val.layer->RemoveAtTime(newTime);
-			    val.layer->Insert(frameCopy);
+			    auto& frameCopy = frameCopies.emplace_back(*keyFramePtr);
+			    frameCopy.time = std::round((time - min + minTime) * 10.0f) / 10.0f;
 		    }
+		    val.layer->InsertAll(std::move(frameCopies)); // copied before inserting, pasting may overwrite the originals
 	    };
 	    TIMELINE_SELECTION_HANDLE_BOTH_CAPTURE(CopyFunc);
     }
@@ -151,10 +147,12 @@ struct TimelineSelection {
             return;
         }
 
-        const auto SetFunc = [num](const auto& val) {
+        const auto SetFunc = [this, num](const auto& val) {
             for (auto* keyFramePtr : val.frames) {
                 keyFramePtr->blendModeID = num;
+                Journal::RecordBlend(objectID, val.layerKey, keyFramePtr->time, num);
             }
+            val.layer->MarkEdited();
         };
 
         TIMELINE_SELECTION_HANDLE_BOTH_CAPTURE(SetFunc);
@@ -172,12 +170,12 @@ struct TimelineSelection {
         return count;
     }
 
-    [[nodiscard]] bool ContainsKeyframe(std::variant<KeyFrame<Vec2List>*, KeyFrame<float>*> frame) const {
+    [[nodiscard]] bool ContainsKeyframe(std::variant<KeyFrame<PackedPolyline>*, KeyFrame<float>*> frame) const {
         bool contains = false;
 
-        if (std::holds_alternative<KeyFrame<Vec2List>*>(frame)) {
-            KeyFrame<Vec2List>* framePtr = std::get<KeyFrame<Vec2List>*>(frame);
-            HandleTypeCapture<Vec2List>([&](const auto& val) {
+        if (std::holds_alternative<KeyFrame<PackedPolyline>*>(frame)) {
+            KeyFrame<PackedPolyline>* framePtr = std::get<KeyFrame<PackedPolyline>*>(frame);
+            HandleTypeCapture<PackedPolyline>([&](const auto& val) {
                 if (contains) return;
                 for (auto* currFrame : val.frames) {
                     if (currFrame == framePtr) contains = true;
@@ -204,20 +202,30 @@ private:
         }
     }
 
-    void HandleAllCapture(const std::function<void(const KeyFrameRowSelection<Vec2List>&)>& vec2ListFuncPtr, const std::function<void(const KeyFrameRowSelection<float>&)>& floatFuncPtr) const {
+    void HandleAllCapture(const std::function<void(const KeyFrameRowSelection<PackedPolyline>&)>& vec2ListFuncPtr, const std::function<void(const KeyFrameRowSelection<float>&)>& floatFuncPtr) const {
         for (const auto& selectionVariant : rowSelections) {
-            if (std::holds_alternative<KeyFrameRowSelection<Vec2List>>(selectionVariant)) {
-                vec2ListFuncPtr(std::get<KeyFrameRowSelection<Vec2List>>(selectionVariant));
+            if (std::holds_alternative<KeyFrameRowSelection<PackedPolyline>>(selectionVariant)) {
+                vec2ListFuncPtr(std::get<KeyFrameRowSelection<PackedPolyline>>(selectionVariant));
             } else {
                 floatFuncPtr(std::get<KeyFrameRowSelection<float>>(selectionVariant));
             }
         }
     }
 
-    void HandleAll(void(* vec2ListFuncPtr)(const KeyFrameRowSelection<Vec2List>& val), void(* floatFuncPtr)(const KeyFrameRowSelection<float>& val)) const {
+    void HandleAllMutable(const std::function<void(KeyFrameRowSelection<PackedPolyline>&)>& vec2ListFuncPtr, const std::function<void(KeyFrameRowSelection<float>&)>& floatFuncPtr) {
+        for (auto& selectionVariant : rowSelections) {
+            if (std::holds_alternative<KeyFrameRowSelection<PackedPolyline>>(selectionVariant)) {
+                vec2ListFuncPtr(std::get<KeyFrameRowSelection<PackedPolyline>>(selectionVariant));
+            } else {
+                floatFuncPtr(std::get<KeyFrameRowSelection<float>>(selectionVariant));
+            }
+        }
+    }
+
+    void HandleAll(void(* vec2ListFuncPtr)(const KeyFrameRowSelection<PackedPolyline>& val), void(* floatFuncPtr)(const KeyFrameRowSelection<float>& val)) const {
         for (const auto& selectionVariant : rowSelections) {
-            if (std::holds_alternative<KeyFrameRowSelection<Vec2List>>(selectionVariant)) {
-                vec2ListFuncPtr(std::get<KeyFrameRowSelection<Vec2List>>(selectionVariant));
+            if (std::holds_alternative<KeyFrameRowSelection<PackedPolyline>>(selectionVariant)) {
+                vec2ListFuncPtr(std::get<KeyFrameRowSelection<PackedPolyline>>(selectionVariant));
             } else {
                 floatFuncPtr(std::get<KeyFrameRowSelection<float>>(selectionVariant));
             }
@@ -246,31 +254,37 @@ public:
 
     [[nodiscard]] bool IsFocused() const { return focused; }
     [[nodiscard]] bool IsPlaying() const { return playing; }
+    [[nodiscard]] Rectangle GetGuiRect() const; // canvas and scroll bar
 
     TimelineSelection GenTimelineSelection();
 
-    bool HasFloatLayer(const std::string& valLabel) {
-        return animator->floatKeyFrameLayers.contains(valLabel);
+    bool HasFloatLayer(Enums::AnimatableParam param) {
+        return animator->floatKeyFrameLayers[param].has_value();
     }
 
     [[nodiscard]] Animator* GetAnimatorPtr() const { return animator; }
 
-    void AddFloatLayer(const std::string& valLabel, float initVal) {
-        animator->floatKeyFrameLayers[valLabel] = {KeyFrameLayer<float>()};
-        UpdateFloat(valLabel, initVal);
+    void AddFloatLayer(Enums::AnimatableParam param, float initVal) {
+        animator->floatKeyFrameLayers[param].emplace();
+        UpdateFloat(param, initVal); // journaled as its first keyframe
     }
 
-    void TryUpdateFloat(const std::string& valLabel, float val) {
-        if (HasFloatLayer(valLabel)) UpdateFloat(valLabel, val);
+    void TryUpdateFloat(Enums::AnimatableParam param, float val) {
+        if (HasFloatLayer(param)) UpdateFloat(param, val);
     }
 
-    void RemoveFloatLayer(const std::string& valLabel) {
-        animator->floatKeyFrameLayers.erase(valLabel);
+    void RemoveFloatLayer(Enums::AnimatableParam param) {
+        animator->floatKeyFrameLayers[param].reset();
+        Journal::RecordRemoveFloatLayer(ActiveObjectID(), param);
     }
 
 
-    void UpdateFloat(const std::string& valLabel, float val) {
-        animator->floatKeyFrameLayers[valLabel].layer.Insert({val, animator->currentTime});
+    void UpdateFloat(Enums::AnimatableParam param, float val) {
+        const KeyFrame<float> frame = {val, animator->currentTime};
+        auto& layer = animator->floatKeyFrameLayers[param];
+        if (!layer) layer.emplace();
+        layer->Insert(frame);
+        Journal::RecordKeyFrame(ActiveObjectID(), param, frame);
     }
 
     void RenderOnionSkin(Mesh2D& plot, Enums::DrawMode drawMode);
@@ -288,6 +302,13 @@ public:
 
     static float RoundToTenth(float val);
 
+    // evaluates and remeshes objects at time across the thread pool, then uploads on the calling (main) thread.
+    // Objects already showing time are skipped.
+    static void SampleObjectsAtTime(const std::vector<ModelObject*>& objects, float time);
+
+    // writes obj's animated points and values at time, false if obj has no keyframes (does not regenerate the mesh)
+    static bool EvaluateAtTime(ModelObject& obj, float time);
+
 private:
 	Shader2D shader2D = Shader2D::Read("shaders/shader2D.vert", "shaders/shader2D.frag");
 
@@ -307,11 +328,13 @@ private:
     bool dragging;
     float lastDragDiff;
 	TimelineScrollBar scrollBar;
+	PlaybackScheduler playbackScheduler;
 
     void TopToBottomLineAt(float x, glm::vec4 color, float width = 0.001f, bool trueTop = false);
 
 
 	[[nodiscard]] float XToTime(float xNP) const;
+	[[nodiscard]] static int ActiveObjectID(); // owner of the active animator
 	[[nodiscard]] float TimeToX(float time) const;
 };
 
@@ -16,6 +16,7 @@ void TimelineScrollBar::Render(Mesh2D &canvas, Shader2D& shader2D) const {
 	// setup
 	RenderTarget::Bind(scene);
 	shader2D.Enable();
+	shader2D.SetModel(Util::Identity());
 
 	// render
 	canvas.AddQuad({-1.0f, -1.0f}, {1.0f, 1.0f}, scrollBackgroundColour);
@@ -54,7 +55,7 @@ void TimelineScrollBar::Render(Mesh2D &canvas, Shader2D& shader2D) const {
 	canvas.AddQuad(Util::Remap01ToNP({end - edgeWidth, 0.0f}), Util::Remap01ToNP({end, 1.0f}), GetEdgeColour(ScrollBarDragInfo::End));
 
 	// finalize
-	canvas.ImmediateClearingRender();
+	canvas.ImmediateClearingRender(Util::Identity());
 	shader2D.Disable();
 	RenderTarget::Unbind();
 }
@@ -0,0 +1,63 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "BlendCurves.h"
+#include "BlendModeManager.h"
+#include <cmath>
+
+std::mutex BlendCurves::mutex;
+std::shared_ptr<const BlendCurves::Table> BlendCurves::latest;
+std::atomic<uint64_t> BlendCurves::version = 0;
+thread_local BlendCurves::ThreadTable BlendCurves::local;
+
+void BlendCurves::Bake(const BlendModeManager& manager) {
+	auto table = std::make_shared<Table>();
+	table->stride = manager.GetNextID();
+	table->samples.assign((size_t) table->stride * table->stride * (SAMPLES + 1), 0.0f);
+
+	for (int fromID = 0; fromID < table->stride; fromID++) {
+		for (int toID = 0; toID < table->stride; toID++) {
+			float* curve = &table->samples[(size_t) (fromID * table->stride + toID) * (SAMPLES + 1)];
+			BlendMode* from = manager.Get(fromID);
+			BlendMode* to = manager.Get(toID);
+
+			for (int i = 0; i <= SAMPLES; i++) {
+				const float t = (float) i / (float) SAMPLES;
+				curve[i] = (from && to) ? BlendMode::Apply(from, to, t) : t;
+			}
+		}
+	}
+
+	std::lock_guard lock(mutex);
+	latest = std::move(table);
+	version.fetch_add(1, std::memory_order_release);
+}
+
+void BlendCurves::Refresh() {
+	std::lock_guard lock(mutex);
+	local.table = latest; // drops this thread's hold on the previous table
+	local.version = version.load(std::memory_order_relaxed);
+}
+
+BlendCurves::Accuracy BlendCurves::Measure(const BlendModeManager& manager) {
+	Accuracy accuracy = {0.0f, -1, -1};
+	const Table* table = Current();
+	if (!table) return accuracy;
+
+	for (int fromID = 0; fromID < table->stride; fromID++) {
+		for (int toID = 0; toID < table->stride; toID++) {
+			BlendMode* from = manager.Get(fromID);
+			BlendMode* to = manager.Get(toID);
+			if (!from || !to) continue;
+
+			const float* curve = &table->samples[(size_t) (fromID * table->stride + toID) * (SAMPLES + 1)];
+			for (int i = 0; i < SAMPLES; i++) {
+				const float t = ((float) i + 0.5f) / (float) SAMPLES;
+				const float error = std::abs((curve[i] + curve[i + 1]) * 0.5f - BlendMode::Apply(from, to, t));
+				if (error > accuracy.maxError) accuracy = {error, fromID, toID};
+			}
+		}
+	}
+	return accuracy;
+}
@@ -0,0 +1,75 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_BLENDCURVES_H
+#define SENIORRESEARCH_BLENDCURVES_H
+
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <algorithm>
+
+class BlendModeManager;
+
+// BlendMode::Apply baked for every (from, to) pair of blend mode IDs into SAMPLES linear segments, so keyframe
+// interpolation is one table read instead of two map lookups and the analytic curve (elastic easing, piecewise search).
+// Rebaked whenever the manager's blend modes change. Apply may run on any thread: each thread holds a reference to the
+// table it last read and only takes the lock to swap it once the version changes, so a superseded table is freed as
+// soon as the last thread still holding it moves on.
+class BlendCurves {
+public:
+	static void Bake(const BlendModeManager& manager);
+
+	[[nodiscard]] static float Apply(int fromID, int toID, float t) {
+		const Table* table = Current();
+		if (!table || fromID < 0 || toID < 0 || fromID >= table->stride || toID >= table->stride) return t;
+
+		const float* curve = &table->samples[(size_t) (fromID * table->stride + toID) * (SAMPLES + 1)];
+		const float x = std::min(std::max(t, 0.0f), 1.0f) * (float) SAMPLES;
+		const int i = std::min((int) x, SAMPLES - 1);
+		return curve[i] + (curve[i + 1] - curve[i]) * (x - (float) i);
+	}
+
+	// bumped by every Bake, so anything derived from the curves can tell it's stale
+	[[nodiscard]] static uint64_t GetVersion() { return version.load(std::memory_order_acquire); }
+
+	struct Accuracy {
+		float maxError;
+		int worstFromID, worstToID;
+	};
+	// the current tables against BlendMode::Apply, halfway between samples where linear interpolation is furthest off
+	[[nodiscard]] static Accuracy Measure(const BlendModeManager& manager);
+
+	static constexpr int SAMPLES = 1024;
+	// EaseInOutElastic jumps by 0.0078 at its piece boundaries (t = 0.45, 0.55), the segment across one is off by
+	// half that (0.0037) halfway through -- the worst of the built-in modes
+	static constexpr float TOLERANCE = 0.01f;
+
+private:
+	struct Table {
+		int stride; // blend mode IDs are [0, stride)
+		std::vector<float> samples; // stride x stride curves of SAMPLES + 1 values
+	};
+	struct ThreadTable {
+		uint64_t version = 0;
+		std::shared_ptr<const Table> table;
+	};
+
+	[[nodiscard]] static const Table* Current() {
+		if (local.version != version.load(std::memory_order_acquire)) Refresh();
+		return local.table.get();
+	}
+	static void Refresh();
+
+	static std::mutex mutex; // guards latest
+	static std::shared_ptr<const Table> latest;
+	static std::atomic<uint64_t> version;
+	static thread_local ThreadTable local;
+};
+
+
+#endif //SENIORRESEARCH_BLENDCURVES_H
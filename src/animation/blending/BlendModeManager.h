@@ -11,6 +11,7 @@
 #include "SineBlendMode.h"
 #include "LinearBlendMode.h"
 #include "EaseBlendModes.h"
+#include "BlendCurves.h"
 #include <vector>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/unordered_map.hpp>
@@ -20,9 +21,15 @@ class BlendModeManager {
 public:
     BlendModeManager() = default;
 
-    BlendMode* Get(int ID) { return blendModes[ID]; }
+    BlendMode* Get(int ID) const { // lookup only, so meshes can be generated on several threads at once
+        const auto it = blendModes.find(ID);
+        return it == blendModes.end() ? nullptr : it->second;
+    }
 
-    void Add(BlendMode* newBlendMode) { blendModes[GenNextID()] = newBlendMode; }
+    void Add(BlendMode* newBlendMode) {
+        blendModes[GenNextID()] = newBlendMode;
+        BlendCurves::Bake(*this);
+    }
 
     std::vector<int> GenAllIDs();
 
@@ -48,6 +55,7 @@ public:
             nextID = ID + 1;
         }
         serializeCustomBlendModes = {};
+        BlendCurves::Bake(*this);
     }
 
     void Init() {
@@ -56,7 +64,7 @@ public:
         blendModes[GenNextID()] = new ElasticInBlendMode();
         blendModes[GenNextID()] = new ElasticOutBlendMode();
         blendModes[GenNextID()] = new ElasticInOutBlendMode();
-
+        BlendCurves::Bake(*this);
     }
 
 private:
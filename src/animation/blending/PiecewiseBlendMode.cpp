@@ -15,6 +15,7 @@ int PiecewiseBlendMode::GetCustomID() const {
 }
 
 float PiecewiseBlendMode::ApplyCustomFunc(float t) const {
+    if (t >= funcPoints.back().x) return funcPoints.back().y; // GetY is 0 past its last point, which made t = 1 snap back
     return Function::GetY(funcPoints, t);
 }
 
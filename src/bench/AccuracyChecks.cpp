@@ -0,0 +1,34 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "AccuracyChecks.h"
+#include "BenchFixtures.h"
+#include "../animation/blending/BlendCurves.h"
+#include "../animation/blending/BlendModes.h"
+#include "../animation/blending/PiecewiseBlendMode.h"
+#include "../util/Util.h"
+
+#include <cmath>
+
+bool AccuracyChecks::Run() {
+	bool passed = true;
+	passed &= BlendCurveTables();
+	return passed;
+}
+
+bool AccuracyChecks::BlendCurveTables() {
+	// the built-in modes plus a custom one, as drawn on the plot: a wobbly ease-in-out
+	Vec2List custom;
+	for (int i = 0; i <= 64; i++) {
+		const float x = (float) i / 64.0f;
+		custom.emplace_back(x, x * x * (3.0f - 2.0f * x) + 0.05f * std::sin(6.0f * (float) M_PI * x));
+	}
+	BlendModes::Add(new PiecewiseBlendMode(custom, BlendModes::GetNextID()));
+
+	const auto accuracy = BlendCurves::Measure(BlendModes::GetManager());
+	const bool passed = accuracy.maxError <= BlendCurves::TOLERANCE;
+	LOG("%-80s max error %.6f (blend modes %i -> %i), tolerance %.6f  %s", "BlendCurves", accuracy.maxError, accuracy.worstFromID,
+	    accuracy.worstToID, BlendCurves::TOLERANCE, passed ? "ok" : "FAILED");
+	return passed;
+}
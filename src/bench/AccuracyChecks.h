@@ -0,0 +1,20 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_ACCURACYCHECKS_H
+#define SENIORRESEARCH_ACCURACYCHECKS_H
+
+
+// bench --check: the tabulated / cached fast paths against what they stand in for. Each check logs its worst error
+// and fails past its tolerance; Run is false if any failed, so the bench exits non-zero.
+class AccuracyChecks {
+public:
+	static bool Run();
+
+private:
+	static bool BlendCurveTables();
+};
+
+
+#endif //SENIORRESEARCH_ACCURACYCHECKS_H
@@ -0,0 +1,145 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "Bench.h"
+#include "../util/Util.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <numeric>
+#include <algorithm>
+
+std::string Bench::Case::ID() const {
+	std::string id = name;
+	for (const auto& [key, value] : params) id += "/" + key + "=" + std::to_string(value);
+	return id;
+}
+
+void Bench::Add(std::string name, Params params, Body body, Hook setup, Hook teardown) {
+	cases.push_back({std::move(name), std::move(params), std::move(body), std::move(setup), std::move(teardown)});
+}
+
+std::vector<Bench::Result> Bench::Run(const Options& options) const {
+	std::vector<Result> results;
+	for (const Case& benchCase : cases) {
+		if (!options.filter.empty() && benchCase.ID().find(options.filter) == std::string::npos) continue;
+
+		if (benchCase.setup) benchCase.setup();
+		const Result result = Measure(benchCase, options);
+		if (benchCase.teardown) benchCase.teardown();
+		LOG("%-80s median %10.4f ms  p95 %10.4f ms  (%d x %d)", result.id.c_str(), result.medianMs, result.p95Ms,
+		    result.repetitions, result.iterations);
+		results.push_back(result);
+	}
+	return results;
+}
+
+Bench::Result Bench::Measure(const Case& benchCase, const Options& options) {
+	using Clock = std::chrono::steady_clock;
+	const auto TimeMs = [&](int iterations) {
+		const auto start = Clock::now();
+		for (int i = 0; i < iterations; i++) sink = sink + benchCase.body();
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	};
+
+	// warmup doubles as calibration, the fastest warm call decides how many calls make up one sample
+	double warmMs = TimeMs(1);
+	for (int i = 1; i < options.warmup; i++) warmMs = std::min(warmMs, TimeMs(1));
+	const int iterations = std::max(1, (int) std::ceil(MIN_SAMPLE_MS / std::max(warmMs, 1e-6)));
+
+	std::vector<double> samples;
+	samples.reserve(options.repetitions);
+	for (int i = 0; i < options.repetitions; i++) samples.push_back(TimeMs(iterations) / iterations);
+	std::sort(samples.begin(), samples.end());
+
+	return {
+		.id=benchCase.ID(),
+		.name=benchCase.name,
+		.params=benchCase.params,
+		.iterations=iterations,
+		.repetitions=options.repetitions,
+		.medianMs=Percentile(samples, 0.5),
+		.p95Ms=Percentile(samples, 0.95),
+		.minMs=samples.front(),
+		.meanMs=std::accumulate(samples.begin(), samples.end(), 0.0) / (double) samples.size(),
+	};
+}
+
+double Bench::Percentile(const std::vector<double>& sorted, double fraction) { // linear between closest ranks
+	const double rank = fraction * (double) (sorted.size() - 1);
+	const auto lower = (size_t) std::floor(rank);
+	const size_t upper = std::min(lower + 1, sorted.size() - 1);
+	return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - (double) lower);
+}
+
+bool Bench::WriteJSON(const std::string& path, const Options& options, const std::vector<Result>& results) {
+	std::ofstream out(path);
+	if (!out) return false;
+
+	char numbers[192];
+	out << "{\n  \"warmup\": " << options.warmup << ",\n  \"repetitions\": " << options.repetitions << ",\n  \"benchmarks\": [";
+	for (size_t i = 0; i < results.size(); i++) {
+		const Result& result = results[i];
+
+		out << (i == 0 ? "\n" : ",\n") << R"(    {"id": ")" << result.id << R"(", "name": ")" << result.name << R"(", "params": {)";
+		for (size_t p = 0; p < result.params.size(); p++) {
+			out << (p == 0 ? "" : ", ") << "\"" << result.params[p].first << "\": " << result.params[p].second;
+		}
+		std::snprintf(numbers, sizeof(numbers), R"("median_ms": %.6f, "p95_ms": %.6f, "min_ms": %.6f, "mean_ms": %.6f)",
+		              result.medianMs, result.p95Ms, result.minMs, result.meanMs);
+		out << "}, \"iterations\": " << result.iterations << ", " << numbers << "}";
+	}
+	out << "\n  ]\n}\n";
+
+	return (bool) out;
+}
+
+bool Bench::ReadJSON(const std::string& path, std::vector<Result>& outResults) {
+	std::ifstream in(path);
+	if (!in) return false;
+	std::stringstream buffer;
+	buffer << in.rdbuf();
+	const std::string json = buffer.str();
+
+	// not a general JSON reader, only picks the fields WriteJSON emits out of each result object
+	const auto StringAfter = [&](const std::string& key, size_t from, size_t to, std::string& out) {
+		const size_t at = json.find("\"" + key + "\": \"", from);
+		if (at == std::string::npos || at >= to) return false;
+		const size_t start = at + key.size() + 5;
+		const size_t end = json.find('"', start);
+		if (end == std::string::npos || end > to) return false;
+		out = json.substr(start, end - start);
+		return true;
+	};
+	const auto NumberAfter = [&](const std::string& key, size_t from, size_t to, double& out) {
+		const size_t at = json.find("\"" + key + "\": ", from);
+		if (at == std::string::npos || at >= to) return false;
+		out = std::strtod(json.c_str() + at + key.size() + 4, nullptr);
+		return true;
+	};
+
+	outResults.clear();
+	size_t at = json.find("{\"id\": ");
+	while (at != std::string::npos) {
+		const size_t next = json.find("{\"id\": ", at + 1);
+		const size_t end = (next == std::string::npos) ? json.size() : next;
+
+		Result result {};
+		double iterations = 0.0;
+		if (StringAfter("id", at, end, result.id) && StringAfter("name", at, end, result.name) && NumberAfter("iterations", at, end, iterations)
+		    && NumberAfter("median_ms", at, end, result.medianMs) && NumberAfter("p95_ms", at, end, result.p95Ms)
+		    && NumberAfter("min_ms", at, end, result.minMs) && NumberAfter("mean_ms", at, end, result.meanMs)) {
+			result.iterations = (int) iterations;
+			outResults.push_back(result);
+		} else {
+			LOG("[Warning]: skipping a malformed result in \"%s\"", path.c_str());
+		}
+		at = next;
+	}
+	return !outResults.empty();
+}
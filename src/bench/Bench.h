@@ -0,0 +1,73 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_BENCH_H
+#define SENIORRESEARCH_BENCH_H
+
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <cstdint>
+
+// Minimal benchmark harness for the `bench` target.
+// Each case is timed in repetitions of `iterations` calls, where iterations is calibrated during warmup so one
+// repetition takes at least MIN_SAMPLE_MS (microsecond-scale cases aren't swamped by clock overhead).
+// Reported times are per call. Bodies return something derived from their result (a vertex count, a byte count),
+// which is folded into a sink so the call can't be optimized away.
+// A case's setup and teardown run untimed around its measurement, and only if it runs (not for --list or when
+// filtered out), for fixtures with side effects such as files on disk or switched global state.
+class Bench {
+public:
+	using Params = std::vector<std::pair<std::string, int>>;
+	using Body = std::function<size_t()>;
+	using Hook = std::function<void()>;
+
+	struct Case {
+		std::string name;
+		Params params;
+		Body body;
+		Hook setup, teardown;
+
+		[[nodiscard]] std::string ID() const; // name/param=value/..., what result files are matched by
+	};
+
+	struct Options {
+		int warmup = 3;
+		int repetitions = 25;
+		std::string filter; // substring of the case ID, empty runs everything
+	};
+
+	struct Result {
+		std::string id;
+		std::string name;
+		Params params;
+		int iterations;
+		int repetitions;
+		double medianMs, p95Ms, minMs, meanMs;
+	};
+
+	void Add(std::string name, Params params, Body body, Hook setup = {}, Hook teardown = {});
+	[[nodiscard]] const std::vector<Case>& GetCases() const { return cases; }
+
+	[[nodiscard]] std::vector<Result> Run(const Options& options) const;
+
+	static bool WriteJSON(const std::string& path, const Options& options, const std::vector<Result>& results);
+	// reads back what WriteJSON wrote (ids and timings, params are left empty), false if the file has no results
+	static bool ReadJSON(const std::string& path, std::vector<Result>& outResults);
+
+	static constexpr double MIN_SAMPLE_MS = 2.0;
+
+private:
+	std::vector<Case> cases;
+
+	[[nodiscard]] static Result Measure(const Case& benchCase, const Options& options);
+	[[nodiscard]] static double Percentile(const std::vector<double>& sorted, double fraction);
+
+	static inline volatile size_t sink = 0;
+};
+
+
+#endif //SENIORRESEARCH_BENCH_H
@@ -0,0 +1,96 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "BenchComparison.h"
+#include "../util/Util.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+int BenchComparison::Run(const std::string& baselinePath, const std::string& candidatePath, const Options& options) {
+	std::vector<Bench::Result> baseline, candidate;
+	if (!Bench::ReadJSON(baselinePath, baseline)) {
+		LOG("[Error]: no results in \"%s\"", baselinePath.c_str());
+		return -1;
+	}
+	if (!Bench::ReadJSON(candidatePath, candidate)) {
+		LOG("[Error]: no results in \"%s\"", candidatePath.c_str());
+		return -1;
+	}
+
+	const std::vector<Row> rows = Compare(baseline, candidate, options);
+
+	int regressions = 0, faster = 0, slower = 0, noisy = 0;
+	LOG("%-80s %12s %12s %9s %8s", "benchmark", "baseline ms", "candidate ms", "speedup", "noise");
+	for (const Row& row : rows) {
+		LOG("%-80s %12.4f %12.4f %8.3fx %7.1f%%  %s", row.id.c_str(), row.baselineMs, row.candidateMs, row.speedup, row.noisePercent,
+		    VerdictName(row.verdict));
+		if (row.verdict == VERDICT_REGRESSION) regressions++;
+		if (row.verdict == VERDICT_FASTER) faster++;
+		if (row.verdict == VERDICT_SLOWER || row.verdict == VERDICT_REGRESSION) slower++;
+		if (row.verdict == VERDICT_NOISY) noisy++;
+	}
+
+	// cases in only one of the files aren't compared, but shouldn't go unnoticed either
+	std::unordered_map<std::string, bool> inCandidate;
+	for (const auto& result : candidate) inCandidate[result.id] = true;
+	for (const auto& result : baseline) {
+		if (!inCandidate.contains(result.id)) LOG("%-80s missing from the candidate", result.id.c_str());
+	}
+
+	LOG("%zu compared: %d faster, %d slower, %d regressions, %d too noisy to judge (threshold %.1f%%)", rows.size(), faster,
+	    slower, regressions, noisy, options.thresholdPercent);
+	return regressions;
+}
+
+std::vector<BenchComparison::Row> BenchComparison::Compare(const std::vector<Bench::Result>& baseline, const std::vector<Bench::Result>& candidate,
+                                                           const Options& options) {
+	std::unordered_map<std::string, const Bench::Result*> baselineByID;
+	for (const auto& result : baseline) baselineByID[result.id] = &result;
+
+	std::vector<Row> rows;
+	for (const auto& result : candidate) { // in the candidate's order
+		const auto it = baselineByID.find(result.id);
+		if (it == baselineByID.end()) continue;
+		const Bench::Result& base = *it->second;
+
+		const double changePercent = ChangePercent(base.medianMs, result.medianMs);
+		const double minChangePercent = ChangePercent(base.minMs, result.minMs);
+		const double noise = std::max({options.noisePercent, SpreadPercent(base), SpreadPercent(result)});
+		const double band = std::min(noise, options.thresholdPercent); // so noise can't hide a regression
+
+		// the fastest samples have to agree, a busy machine slows the median of a whole run down but rarely its best case
+		Verdict verdict = VERDICT_SAME;
+		if (std::min(changePercent, minChangePercent) > options.thresholdPercent) {
+			verdict = VERDICT_REGRESSION;
+		} else if (changePercent > band && minChangePercent > band) {
+			verdict = VERDICT_SLOWER;
+		} else if (-changePercent > band && -minChangePercent > band) {
+			verdict = VERDICT_FASTER;
+		} else if (noise > options.thresholdPercent) {
+			verdict = VERDICT_NOISY;
+		}
+
+		rows.push_back({result.id, base.medianMs, result.medianMs, base.medianMs / std::max(result.medianMs, 1e-9), noise, verdict});
+	}
+	return rows;
+}
+
+double BenchComparison::ChangePercent(double baselineMs, double candidateMs) { // above 0 is slower
+	return (candidateMs / std::max(baselineMs, 1e-9) - 1.0) * 100.0;
+}
+
+double BenchComparison::SpreadPercent(const Bench::Result& result) {
+	return (result.p95Ms / std::max(result.medianMs, 1e-9) - 1.0) * 100.0;
+}
+
+const char* BenchComparison::VerdictName(Verdict verdict) {
+	switch (verdict) {
+		case VERDICT_FASTER: return "faster";
+		case VERDICT_SLOWER: return "slower";
+		case VERDICT_REGRESSION: return "REGRESSION";
+		case VERDICT_NOISY: return "too noisy";
+		default: return "~";
+	}
+}
@@ -0,0 +1,50 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_BENCHCOMPARISON_H
+#define SENIORRESEARCH_BENCHCOMPARISON_H
+
+
+#include <string>
+#include <vector>
+#include "Bench.h"
+
+// bench --compare: matches two result files by case ID and compares medians.
+// A case is a regression once its median and its fastest sample are both slower by more than thresholdPercent, however
+// noisy it is. Below that, it only counts as slower or faster once both changes are past its noise band -- the larger
+// of noisePercent and the p95 spread above the median seen in either run, capped at thresholdPercent. A case whose
+// spread is past the threshold and that shows no change is reported as too noisy to judge rather than as unchanged.
+class BenchComparison {
+public:
+	struct Options {
+		double thresholdPercent = 5.0;
+		double noisePercent = 2.0;
+	};
+
+	enum Verdict {
+		VERDICT_SAME, VERDICT_FASTER, VERDICT_SLOWER, VERDICT_REGRESSION, VERDICT_NOISY,
+	};
+
+	struct Row {
+		std::string id;
+		double baselineMs, candidateMs;
+		double speedup; // baseline / candidate, above 1 is faster
+		double noisePercent; // before capping at the threshold
+		Verdict verdict;
+	};
+
+	// prints the comparison, returns the number of regressions (-1 if either file couldn't be read)
+	static int Run(const std::string& baselinePath, const std::string& candidatePath, const Options& options);
+
+	[[nodiscard]] static std::vector<Row> Compare(const std::vector<Bench::Result>& baseline, const std::vector<Bench::Result>& candidate,
+	                                              const Options& options);
+
+private:
+	[[nodiscard]] static double ChangePercent(double baselineMs, double candidateMs);
+	[[nodiscard]] static double SpreadPercent(const Bench::Result& result);
+	[[nodiscard]] static const char* VerdictName(Verdict verdict);
+};
+
+
+#endif //SENIORRESEARCH_BENCHCOMPARISON_H
@@ -0,0 +1,125 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "BenchFixtures.h"
+#include "../generation/Sampler.h"
+#include "../misc/ProjectFile.h"
+#include "../misc/Serialization.h"
+#include "../util/ModelObjectHelper.h"
+#include "../animation/blending/BlendModes.h"
+
+#include <cmath>
+#include <unordered_map>
+
+std::shared_ptr<BenchFixtures::Demo> BenchFixtures::LoadDemo(const std::string& name) {
+	auto demo = std::make_shared<Demo>();
+	demo->name = name;
+	demo->path = std::string(BENCH_DEMO_DIRECTORY) + "/" + name + ".mdl";
+
+	// Deserialize installs the project's blend modes globally, they're kept with the demo and the previous ones restored
+	const BlendModeManager previous = BlendModes::GetManager();
+	try {
+		Serialization serialization = ProjectFile::Read(demo->path);
+		for (ModelObject* obj : serialization.Deserialize()) demo->objects.push_back(ModelObjectHelper::CreateInitialShareableFromPtr(obj));
+		demo->blendModes = BlendModes::GetManager();
+	} catch (const std::exception& e) {
+		LOG("[Warning]: skipping demo \"%s\": %s", demo->path.c_str(), e.what());
+		demo->objects.clear();
+	}
+	BlendModes::SetManager(previous);
+	BlendCurves::Bake(BlendModes::GetManager());
+
+	if (demo->objects.empty()) return nullptr;
+	return demo;
+}
+
+void BenchFixtures::SwapBlendModes(Demo& demo) {
+	const BlendModeManager global = BlendModes::GetManager();
+	BlendModes::SetManager(demo.blendModes);
+	demo.blendModes = global;
+	BlendCurves::Bake(BlendModes::GetManager());
+}
+
+std::vector<std::shared_ptr<ModelObject>> BenchFixtures::Demo::CloneObjects() const {
+	std::unordered_map<const ModelObject*, ModelObject*> originalToClone;
+	std::vector<std::shared_ptr<ModelObject>> clones;
+	for (const auto& obj : objects) {
+		ModelObject* clone = obj->Clone();
+		originalToClone[obj.get()] = clone;
+		clones.push_back(ModelObjectHelper::CreateInitialShareableFromPtr(clone));
+	}
+	for (const auto& clone : clones) clone->RemapHierarchy(originalToClone); // as ProjectSaver::TakeSnapshot
+	return clones;
+}
+
+Vec2List BenchFixtures::OctopusProfile(int pointCount) {
+	Vec2List points;
+	points.reserve(pointCount);
+	for (int i = 0; i < pointCount; i++) {
+		const float u = (float) i / (float) (pointCount - 1);
+		const float mantle = 0.55f * std::sqrt(std::max(std::sin((float) M_PI * std::min(u / 0.45f, 1.0f)), 0.0f));
+		const float tentacle = 0.18f * (1.0f - u) + 0.02f;
+		points.emplace_back(-1.0f + 2.5f * u, std::max(mantle, tentacle));
+	}
+	return points;
+}
+
+Vec2List BenchFixtures::OctopusCurl(int pointCount) {
+	Vec2List points;
+	points.reserve(pointCount);
+	for (int i = 0; i < pointCount; i++) {
+		const float u = (float) i / (float) (pointCount - 1);
+		const float s = std::max(u - 0.4f, 0.0f) / 0.6f; // only the tentacle curls
+		points.emplace_back(-1.0f + 2.5f * u, 0.35f * s * s * std::sin(3.0f * (float) M_PI * s));
+	}
+	return points;
+}
+
+Vec2List BenchFixtures::LegOutline(int pointCount) {
+	return Resample({
+		{-0.30f, 1.00f}, {-0.34f, 0.55f}, {-0.20f, 0.05f}, {-0.24f, -0.40f}, {-0.14f, -0.85f}, // front: thigh, knee, shin
+		{0.35f, -0.92f}, {0.38f, -1.00f}, // toe
+		{-0.22f, -1.02f}, {-0.30f, -0.95f}, // sole, heel
+		{-0.02f, -0.80f}, {0.08f, -0.30f}, {0.02f, 0.05f}, {0.14f, 0.55f}, {0.12f, 1.00f}, // back: calf, knee, thigh
+	}, pointCount);
+}
+
+KeyFrameLayer<float> BenchFixtures::FloatLayer(int frameCount) {
+	const std::vector<int> blendModeIDs = BlendModes::GenAllIDs();
+
+	KeyFrameLayer<float> layer;
+	for (int i = 0; i < frameCount; i++) {
+		layer.Insert({std::sin((float) i), (float) i * 0.5f, blendModeIDs[i % blendModeIDs.size()]});
+	}
+	return layer;
+}
+
+std::shared_ptr<Lathe> BenchFixtures::Octopus(int pointCount) {
+	auto lathe = std::make_shared<Lathe>();
+	lathe->GetPointsRefByMode(Enums::MODE_PLOT) = OctopusProfile(pointCount);
+	lathe->GetPointsRefByMode(Enums::MODE_GRAPH_Y) = OctopusCurl(pointCount);
+	return lathe;
+}
+
+std::shared_ptr<CrossSectional> BenchFixtures::Leg(int pointCount) {
+	auto crossSectional = std::make_shared<CrossSectional>();
+	crossSectional->GetPointsRefByMode(Enums::MODE_PLOT) = LegOutline(pointCount);
+	return crossSectional;
+}
+
+std::vector<std::shared_ptr<ModelObject>> BenchFixtures::Scene(int objectCount, int pointCount) {
+	std::vector<std::shared_ptr<ModelObject>> objects;
+	for (int i = 0; i < objectCount; i++) {
+		std::shared_ptr<ModelObject> obj;
+		if (i % 2 == 0) obj = Octopus(pointCount);
+		else obj = Leg(pointCount);
+		obj->SetPos({(float) i * 1.5f, 0.0f, 0.0f});
+		objects.push_back(std::move(obj));
+	}
+	return objects;
+}
+
+Vec2List BenchFixtures::Resample(const Vec2List& corners, int pointCount) {
+	return Sampler::SampleTo(corners, pointCount);
+}
@@ -0,0 +1,60 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_BENCHFIXTURES_H
+#define SENIORRESEARCH_BENCHFIXTURES_H
+
+
+#include <memory>
+#include <vector>
+#include <string>
+#include "../util/Util.h"
+#include "../generation/Lathe.h"
+#include "../generation/CrossSectional.h"
+#include "../animation/KeyFrameLayer.h"
+#include "../animation/blending/BlendModeManager.h"
+
+#ifndef BENCH_DEMO_DIRECTORY
+#define BENCH_DEMO_DIRECTORY "output" // set by CMake to the repo's output/, where the README demos are saved
+#endif
+
+// Benchmark inputs. The README demo projects are loaded as saved, with their real strokes, keyframes and params;
+// the synthetic shapes are only for sweeps over point or keyframe counts, which no saved project covers.
+// Objects are never put through UpdateMesh, so nothing here touches GL.
+class BenchFixtures {
+public:
+	// a saved project, its objects ready to mesh and evaluate
+	struct Demo {
+		std::string name, path;
+		std::vector<std::shared_ptr<ModelObject>> objects;
+		BlendModeManager blendModes; // the project's own (custom modes included), its keyframes refer to these IDs
+
+		[[nodiscard]] std::vector<std::shared_ptr<ModelObject>> CloneObjects() const; // for cases that change them
+	};
+
+	// Figures 1-4 and 6: jake run, metal (secondary cross sections), the leg iterations, gary the snail
+	static constexpr const char* DEMO_NAMES[] = {"jake run", "metal", "leg v1", "leg v2", "leg v3", "gary"};
+
+	static std::shared_ptr<Demo> LoadDemo(const std::string& name); // nullptr (and a warning) if it can't be read
+	static void SwapBlendModes(Demo& demo); // exchanges the demo's blend modes with the global ones
+
+	// mantle bulb into a tapering tentacle, x along the axis and y the radius
+	static Vec2List OctopusProfile(int pointCount);
+	static Vec2List OctopusCurl(int pointCount); // lathe graph Y, the tentacle curling up
+
+	// side-view outline of a leg, drawn down the front, along the sole and back up the heel
+	static Vec2List LegOutline(int pointCount);
+
+	static KeyFrameLayer<float> FloatLayer(int frameCount); // a param keyed at every blend mode in turn
+
+	static std::shared_ptr<Lathe> Octopus(int pointCount);
+	static std::shared_ptr<CrossSectional> Leg(int pointCount);
+	static std::vector<std::shared_ptr<ModelObject>> Scene(int objectCount, int pointCount); // octopi and legs in a row
+
+private:
+	static Vec2List Resample(const Vec2List& corners, int pointCount);
+};
+
+
+#endif //SENIORRESEARCH_BENCHFIXTURES_H
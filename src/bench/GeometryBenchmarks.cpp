@@ -0,0 +1,282 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "GeometryBenchmarks.h"
+#include "../generation/Revolver.h"
+#include "../generation/Sampler.h"
+#include "../generation/CrossSectionTracer.h"
+#include "../gl/Normals.h"
+#include "../gl/Mesh.h"
+#include "../exporting/ObjExporter.h"
+#include "../misc/ProjectFile.h"
+#include "../animation/Timeline.h"
+
+#include <sstream>
+#include <filesystem>
+#include <boost/archive/binary_oarchive.hpp>
+
+void GeometryBenchmarks::Register(Bench& bench) {
+	Demos demos;
+	for (const char* name : BenchFixtures::DEMO_NAMES) {
+		if (auto demo = BenchFixtures::LoadDemo(name)) demos.push_back(std::move(demo));
+	}
+
+	RegisterRevolve(bench);
+	RegisterSampling(bench);
+	RegisterTracing(bench, demos);
+	RegisterMesh(bench);
+	RegisterKeyFrames(bench);
+	RegisterExport(bench);
+	RegisterSerialization(bench);
+	for (const auto& demo : demos) RegisterDemo(bench, demo);
+}
+
+void GeometryBenchmarks::RegisterRevolve(Bench& bench) {
+	struct Input {
+		Vec2List profile, curl, crossSection;
+	};
+
+	// the cross-section path (secondary cross sections resampled per ring) is timed on metal, see RegisterDemo
+	for (int pointCount : {64, 256, 1024}) {
+		for (int ringPoints : {16, 64}) {
+			auto input = std::make_shared<Input>(Input{BenchFixtures::OctopusProfile(pointCount), BenchFixtures::OctopusCurl(pointCount), {}});
+			const Bench::Params params = {{"points", pointCount}, {"ring_points", ringPoints}};
+
+			bench.Add("Revolver::Revolve", params, [input, ringPoints] {
+				const auto [vertices, indices] = Revolver::Revolve(input->profile, {
+						.countPerRing=ringPoints,
+						.leanScalar=0.25f,
+						.graphY=input->curl,
+						.graphZ={},
+						.crossSectionPoints=input->crossSection,
+						.crossSectionSnapPointFunc=std::nullopt,
+				});
+				return vertices.size() + indices.size();
+			});
+		}
+	}
+}
+
+void GeometryBenchmarks::RegisterSampling(Bench& bench) {
+	for (int pointCount : {200, 2000}) {
+		auto outline = std::make_shared<const Vec2List>(BenchFixtures::LegOutline(pointCount));
+
+		for (int samplesPerUnit : {10, 40, 160}) {
+			bench.Add("Sampler::DumbSample", {{"points", pointCount}, {"samples_per_unit", samplesPerUnit}}, [outline, samplesPerUnit] {
+				return Sampler::DumbSample(*outline, 1.0f / (float) samplesPerUnit).size();
+			});
+		}
+		for (int sampleCount : {32, 512}) {
+			bench.Add("Sampler::SampleTo", {{"points", pointCount}, {"samples", sampleCount}}, [outline, sampleCount] {
+				return Sampler::SampleTo(*outline, sampleCount).size();
+			});
+		}
+	}
+}
+
+void GeometryBenchmarks::RegisterTracing(Bench& bench, const Demos& demos) {
+	struct Input {
+		Vec2List bound, axis, crossSection;
+		std::vector<CrossSectionTracer::Segment> segments;
+		float sampleLength;
+		int ringPoints;
+
+		[[nodiscard]] CrossSectionTracer::CrossSectionTraceData TraceData() { // as CrossSectional::GenTraceData
+			return {ringPoints, false, true, sampleLength, crossSection};
+		}
+	};
+
+	// the largest drawn cross-sectional outline of each demo, traced at a range of sample lengths and ring counts
+	for (const auto& demo : demos) {
+		Vec2List outline;
+		for (const auto& obj : demo->objects) {
+			const Vec2List& points = obj->GetPointsRefByMode(Enums::MODE_PLOT);
+			if (obj->GetType() == Enums::CROSS_SECTIONAL && points.size() > outline.size()) outline = points;
+		}
+		if (outline.size() < 2) continue;
+
+		for (int samplesPerUnit : {10, 40}) {
+			for (int ringPoints : {16, 64}) {
+				// as CrossSectional::GenMeshData with an auto-generated chordal axis
+				const float sampleLength = 1.0f / (float) samplesPerUnit;
+				auto input = std::make_shared<Input>(Input{Sampler::DumbSample(outline, sampleLength),
+				                                           CrossSectionTracer::AutoGenChordalAxis(outline, sampleLength), {}, {}, sampleLength, ringPoints});
+				input->segments = CrossSectionTracer::TraceSegments(input->bound, input->axis, input->TraceData());
+				const Bench::Params params = {{"samples_per_unit", samplesPerUnit}, {"ring_points", ringPoints}};
+
+				bench.Add("CrossSectionTracer::TraceSegments (" + demo->name + ")", params, [input] {
+					return CrossSectionTracer::TraceSegments(input->bound, input->axis, input->TraceData()).size();
+				});
+				bench.Add("CrossSectionTracer::Inflate (" + demo->name + ")", params, [input] {
+					const auto [vertices, indices] = CrossSectionTracer::Inflate(input->segments, input->TraceData());
+					return vertices.size() + indices.size();
+				});
+			}
+		}
+	}
+}
+
+void GeometryBenchmarks::RegisterMesh(Bench& bench) {
+	const Vec2List noPoints;
+	for (int pointCount : {256, 1024}) {
+		const int ringPoints = 64;
+		const Vec2List profile = BenchFixtures::OctopusProfile(pointCount);
+		auto tuple = std::make_shared<const std::tuple<Vec3List, std::vector<GLuint>>>(Revolver::Revolve(profile, {
+				.countPerRing=ringPoints,
+				.graphY=noPoints,
+				.graphZ=noPoints,
+				.crossSectionPoints=noPoints,
+				.crossSectionSnapPointFunc=std::nullopt,
+		}));
+		const Bench::Params params = {{"points", pointCount}, {"ring_points", ringPoints}};
+
+		bench.Add("Normals::Define", params, [tuple] {
+			const auto& [vertices, indices] = *tuple;
+			return Normals::Define((const GLfloat*) vertices.data(), indices.data(), vertices.size() * 3, indices.size()).size();
+		});
+
+		bench.Add("Mesh::Intersect", params, [tuple] { // straight through the mantle, every triangle is tested
+			const Ray ray = {{-0.5f, 0.0f, 5.0f}, {0.0f, 0.0f, -1.0f}};
+			return (size_t) Mesh::Intersect(*tuple, glm::mat4(1.0f), nullptr, ray).has_value();
+		});
+	}
+}
+
+void GeometryBenchmarks::RegisterKeyFrames(Bench& bench) {
+	const int evaluations = 1000;
+	for (int frameCount : {8, 256}) {
+		auto layer = std::make_shared<KeyFrameLayer<float>>(BenchFixtures::FloatLayer(frameCount));
+		const float endTime = layer->frames.back().time;
+
+		bench.Add("KeyFrameLayer<float>::GetAnimatedVal", {{"frames", frameCount}, {"evaluations", evaluations}}, [layer, endTime] {
+			float sum = 0.0f;
+			for (int i = 0; i < evaluations; i++) sum += layer->GetAnimatedVal(endTime * (float) i / (float) evaluations);
+			return (size_t) std::abs(sum);
+		});
+	}
+
+	// stroke layers are timed on the demos' own keyframes, see RegisterDemo
+}
+
+void GeometryBenchmarks::RegisterExport(Bench& bench) {
+	for (int objectCount : {2, 8}) {
+		const int pointCount = 256;
+		auto objects = std::make_shared<const std::vector<std::shared_ptr<ModelObject>>>(BenchFixtures::Scene(objectCount, pointCount));
+
+		bench.Add("ObjExporter::GenerateFileContents", {{"objects", objectCount}, {"points", pointCount}}, [objects] {
+			return ObjExporter::GenerateFileContents(*objects).size();
+		});
+	}
+}
+
+void GeometryBenchmarks::RegisterSerialization(Bench& bench) {
+	for (int objectCount : {2, 8}) {
+		const int pointCount = 256;
+		auto objects = std::make_shared<const std::vector<std::shared_ptr<ModelObject>>>(BenchFixtures::Scene(objectCount, pointCount));
+		const auto RawObjects = [objects] {
+			std::vector<ModelObject*> raw;
+			for (const auto& obj : *objects) raw.push_back(obj.get());
+			return raw;
+		};
+		const Bench::Params params = {{"objects", objectCount}, {"points", pointCount}};
+
+		bench.Add("Serialization::Save", params, [RawObjects] { // the scene section of ProjectFile::Write, without the disk
+			std::ostringstream stream(std::ios::binary);
+			{
+				boost::archive::binary_oarchive oa(stream);
+				oa << Serialization(RawObjects(), {});
+			}
+			return stream.str().size();
+		});
+
+		// the file is only written if the case runs, and removed after it
+		const std::string path = (std::filesystem::temp_directory_path() / ("bench_scene_" + std::to_string(objectCount) + ".mdl")).string();
+		bench.Add("ProjectFile::Read", params, [path] {
+			return ReadProjectFile(path);
+		}, [path, RawObjects] {
+			if (!ProjectFile::Write(path, "bench", Serialization(RawObjects(), {}))) LOG("[Error]: could not write \"%s\"", path.c_str());
+		}, [path] {
+			std::error_code err;
+			std::filesystem::remove(path, err);
+		});
+	}
+}
+
+void GeometryBenchmarks::RegisterDemo(Bench& bench, const std::shared_ptr<BenchFixtures::Demo>& demo) {
+	const auto objects = std::make_shared<const std::vector<std::shared_ptr<ModelObject>>>(demo->CloneObjects());
+	const Bench::Params params = {{"objects", (int) objects->size()}};
+	const std::string suffix = " (" + demo->name + ")";
+	const Bench::Hook useBlendModes = [demo] { BenchFixtures::SwapBlendModes(*demo); }; // swapped back in teardown
+
+	bench.Add("ModelObject::GenerateMesh" + suffix, params, [objects] { // every object as saved, secondary cross sections included
+		size_t count = 0;
+		for (const auto& obj : *objects) count += obj->GenerateMesh().data.vertexData.size();
+		return count;
+	}, useBlendModes, useBlendModes);
+
+	// the playback path: every animated object evaluated across its keyframes, then meshed
+	auto animated = std::make_shared<std::vector<std::shared_ptr<ModelObject>>>();
+	float startTime = INFINITY, endTime = -INFINITY;
+	for (const auto& obj : demo->CloneObjects()) {
+		const auto range = obj->GetAnimatorPtr()->GetAnimatedRange();
+		if (!range) continue;
+		animated->push_back(obj);
+		startTime = std::min(startTime, range->first);
+		endTime = std::max(endTime, range->second);
+	}
+	if (!animated->empty()) {
+		const int evaluations = 32;
+		const Bench::Params animatedParams = {{"objects", (int) animated->size()}, {"evaluations", evaluations}};
+		const auto TimeAt = [startTime, endTime](int i) { return startTime + (endTime - startTime) * ((float) i + 0.5f) / (float) evaluations; };
+
+		bench.Add("Timeline::EvaluateAtTime" + suffix, animatedParams, [animated, TimeAt] {
+			size_t count = 0;
+			for (int i = 0; i < evaluations; i++) {
+				for (const auto& obj : *animated) count += Timeline::EvaluateAtTime(*obj, TimeAt(i));
+			}
+			return count;
+		}, useBlendModes, useBlendModes);
+
+		bench.Add("Timeline::EvaluateAtTime + GenerateMesh" + suffix, {{"objects", (int) animated->size()}, {"evaluations", 4}}, [animated, TimeAt] {
+			size_t count = 0;
+			for (int i = 0; i < evaluations; i += evaluations / 4) {
+				for (const auto& obj : *animated) {
+					Timeline::EvaluateAtTime(*obj, TimeAt(i));
+					count += obj->GenerateMesh().data.vertexData.size();
+				}
+			}
+			return count;
+		}, useBlendModes, useBlendModes);
+	}
+
+	bench.Add("ObjExporter::GenerateFileContents" + suffix, params, [objects] {
+		return ObjExporter::GenerateFileContents(*objects).size();
+	}, useBlendModes, useBlendModes);
+
+	const auto RawObjects = [objects] {
+		std::vector<ModelObject*> raw;
+		for (const auto& obj : *objects) raw.push_back(obj.get());
+		return raw;
+	};
+	bench.Add("Serialization::Save" + suffix, params, [RawObjects] {
+		std::ostringstream stream(std::ios::binary);
+		{
+			boost::archive::binary_oarchive oa(stream);
+			oa << Serialization(RawObjects(), {});
+		}
+		return stream.str().size();
+	}, useBlendModes, useBlendModes);
+
+	bench.Add("ProjectFile::Read" + suffix, params, [path = demo->path] { // the saved file itself, legacy layout and all
+		return ReadProjectFile(path);
+	});
+}
+
+size_t GeometryBenchmarks::ReadProjectFile(const std::string& path) {
+	const Serialization serialization = ProjectFile::Read(path);
+	// nothing adopts the read objects, freed here so iterations don't pile up memory
+	for (Lathe* lathe : serialization.lathes) delete lathe;
+	for (CrossSectional* crossSectional : serialization.crossSectionals) delete crossSectional;
+	return serialization.order.size();
+}
@@ -0,0 +1,36 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_GEOMETRYBENCHMARKS_H
+#define SENIORRESEARCH_GEOMETRYBENCHMARKS_H
+
+
+#include <memory>
+#include <vector>
+#include "Bench.h"
+#include "BenchFixtures.h"
+
+// The geometry core's benchmark cases: fixtures are built (or demo projects read) when a case is registered, anything
+// with side effects is left to the case's setup. Only the call itself is timed.
+class GeometryBenchmarks {
+public:
+	static void Register(Bench& bench);
+
+private:
+	using Demos = std::vector<std::shared_ptr<BenchFixtures::Demo>>;
+
+	static void RegisterRevolve(Bench& bench);
+	static void RegisterSampling(Bench& bench);
+	static void RegisterTracing(Bench& bench, const Demos& demos);
+	static void RegisterMesh(Bench& bench);
+	static void RegisterKeyFrames(Bench& bench);
+	static void RegisterExport(Bench& bench);
+	static void RegisterSerialization(Bench& bench);
+	static void RegisterDemo(Bench& bench, const std::shared_ptr<BenchFixtures::Demo>& demo);
+
+	static size_t ReadProjectFile(const std::string& path); // the read objects are freed again
+};
+
+
+#endif //SENIORRESEARCH_GEOMETRYBENCHMARKS_H
@@ -0,0 +1,87 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "Bench.h"
+#include "GeometryBenchmarks.h"
+#include "BenchComparison.h"
+#include "AccuracyChecks.h"
+#include "../util/Util.h"
+#include "../animation/blending/BlendModes.h"
+
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+
+// bench [--warmup N] [--reps N] [--filter SUBSTRING] [--out PATH] [--list]
+// bench --compare BASELINE.json CANDIDATE.json [--threshold PERCENT] [--noise PERCENT]
+// bench --check
+// Runs headless: no window or GL context is created, only the CPU side of the geometry core is measured.
+// Comparing exits with 1 if any case regressed past the threshold, checking if any accuracy check failed, so either
+// can gate a change.
+int main(int argc, char** argv) {
+	Bench::Options options;
+	std::string outPath = "bench_results.json";
+	bool list = false, check = false;
+
+	BenchComparison::Options compareOptions;
+	std::string baselinePath, candidatePath;
+
+	for (int i = 1; i < argc; i++) {
+		const auto Value = [&]() -> const char* {
+			if (i + 1 >= argc) {
+				LOG("[Error]: %s expects a value", argv[i]);
+				return nullptr;
+			}
+			return argv[++i];
+		};
+
+		const char* value = nullptr;
+		if (std::strcmp(argv[i], "--list") == 0) list = true;
+		else if (std::strcmp(argv[i], "--check") == 0) check = true;
+		else if (std::strcmp(argv[i], "--warmup") == 0 && (value = Value())) options.warmup = std::max(1, std::atoi(value));
+		else if (std::strcmp(argv[i], "--reps") == 0 && (value = Value())) options.repetitions = std::max(1, std::atoi(value));
+		else if (std::strcmp(argv[i], "--filter") == 0 && (value = Value())) options.filter = value;
+		else if (std::strcmp(argv[i], "--out") == 0 && (value = Value())) outPath = value;
+		else if (std::strcmp(argv[i], "--compare") == 0 && (value = Value())) {
+			baselinePath = value;
+			if ((value = Value())) candidatePath = value;
+		}
+		else if (std::strcmp(argv[i], "--threshold") == 0 && (value = Value())) compareOptions.thresholdPercent = std::atof(value);
+		else if (std::strcmp(argv[i], "--noise") == 0 && (value = Value())) compareOptions.noisePercent = std::atof(value);
+		else {
+			LOG("usage: bench [--warmup N] [--reps N] [--filter SUBSTRING] [--out PATH] [--list]");
+			LOG("       bench --compare BASELINE.json CANDIDATE.json [--threshold PERCENT] [--noise PERCENT]");
+			LOG("       bench --check");
+			return 2;
+		}
+	}
+
+	if (!baselinePath.empty()) {
+		if (candidatePath.empty()) return 2;
+		const int regressions = BenchComparison::Run(baselinePath, candidatePath, compareOptions);
+		if (regressions < 0) return 2;
+		return regressions > 0 ? 1 : 0;
+	}
+
+	BlendModes::GetManager().Init(); // as Program does, keyframes need the built-in blend modes
+
+	if (check) return AccuracyChecks::Run() ? 0 : 1;
+
+	Bench bench;
+	GeometryBenchmarks::Register(bench);
+
+	if (list) {
+		for (const auto& benchCase : bench.GetCases()) LOG("%s", benchCase.ID().c_str());
+		return 0;
+	}
+
+	const std::vector<Bench::Result> results = bench.Run(options);
+	if (!Bench::WriteJSON(outPath, options, results)) {
+		LOG("[Error]: could not write \"%s\"", outPath.c_str());
+		return 1;
+	}
+	LOG("%zu results written to %s", results.size(), outPath.c_str());
+	return 0;
+}
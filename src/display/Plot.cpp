@@ -9,7 +9,9 @@
 #include "../screens/MainScreen.h"
 
 Plot::Plot(const GLWindow &window) :
-	graphScene(window.GetBufferWidth(), window.GetBufferHeight()) {}
+	graphScene(window.GetBufferWidth(), window.GetBufferHeight()) {
+	for (Mesh2D* layer : {&gridLayer, &onionSkinLayer, &strokeLayer}) layer->usageHint = GL_STATIC_DRAW;
+}
 
 void Plot::Update(Project &project, float deltaTime) {
 	onScreen = Util::NormalizeToRectNPFlipped(Program::GetInput().GetMouse(), plotRect);
@@ -33,18 +35,28 @@ void Plot::Render(const Project& project) {
 
 	shader2D.Enable();
 
-	shader2D.SetModel(graphView.GenProjection());
-	plot.SetLineScale(graphView.scale);
+	const glm::mat4 projection = graphView.GenProjection();
+	shader2D.SetModel(projection);
+	for (Mesh2D* layer : {&gridLayer, &onionSkinLayer, &strokeLayer, &plot}) layer->SetLineScale(graphView.scale);
 
-	plot.AddQuad({-1.0f, 0.0f}, {1.0f, -1.0f}, {1.0f, 1.0f, 1.0f, 1.0f});
-	graphView.Render({plot, Program::GetInput()});
+	gridLayer.RetainedRender(projection, [&](Mesh2D& layer) {
+		layer.AddQuad({-1.0f, 0.0f}, {1.0f, -1.0f}, {1.0f, 1.0f, 1.0f, 1.0f});
+		graphView.RenderGrid(layer);
+	});
 
 	Timeline& timeline = MainScreen::GetComponents().timeline;
-	if (!timeline.IsPlaying()) timeline.RenderOnionSkin(plot, drawMode);
-
-	project.GetCurrentModelObject()->Render2D({plot, drawMode, onScreen, graphView, editContext, Program::GetInput()});
-
-	plot.ImmediateClearingRender();
+	onionSkinLayer.RetainedRender(projection, [&](Mesh2D& layer) {
+		if (!timeline.IsPlaying()) timeline.RenderOnionSkin(layer, drawMode);
+	});
+
+	ModelObject& modelObject = *project.GetCurrentModelObject();
+	strokeLayer.RetainedRender(projection, [&](Mesh2D& layer) {
+		modelObject.RenderSelf2D({layer, drawMode, onScreen, graphView, editContext, Program::GetInput()});
+	});
+
+	graphView.RenderGizmos({plot, Program::GetInput()});
+	modelObject.RenderGizmos2D({plot, drawMode, onScreen, graphView, editContext, Program::GetInput()});
+	plot.ImmediateClearingRender(projection);
 
 	shader2D.Disable();
 	RenderTarget::Unbind();
@@ -20,6 +20,7 @@ public:
 	void ToolbarGui(Project& project);
 
 	[[nodiscard]] Enums::DrawMode GetDrawMode() const { return drawMode; }
+	[[nodiscard]] const Rectangle& GetPlotRect() const { return plotRect; }
 private:
 	void HandleUndoing();
 	void LayerClearing(Project& project);
@@ -30,7 +31,8 @@ private:
 	Shader2D shader2D = Shader2D::Read("shaders/shader2D.vert", "shaders/shader2D.frag");
 	RenderTarget graphScene; // initialized in constructor TODO: re-impl on resize
 	GraphView graphView;
-	Mesh2D plot;
+	Mesh2D gridLayer, onionSkinLayer, strokeLayer; // retained, re-tessellated only when their contents or the view change
+	Mesh2D plot; // gizmos, rebuilt every frame
 	Rectangle plotRect; // set per-frame via gui
 	EditingContext editContext;
 	Vec2 onScreen {};
@@ -7,21 +7,16 @@
 #include "../program/Program.h"
 #include "../screens/MainScreen.h"
 #include "../gl/Display3DContext.h"
+#include "../misc/Journal.h"
 
 SceneView3D::SceneView3D(const GLWindow &window) :
 	modelScene(window.GetBufferWidth(), window.GetBufferHeight(), true),
+	sceneCache(window.GetBufferWidth(), window.GetBufferHeight(), true),
 	projection(glm::perspective(45.0f, (GLfloat)window.GetBufferWidth()/(GLfloat)window.GetBufferHeight(), Z_NEAR, Z_FAR)) {}
 
 void SceneView3D::Render(Project &project) {
 	const Input& input = Program::GetInput();
 
-	RenderTarget::Bind(modelScene);
-
-	// Clear Background
-	const float backgroundLevel3D = 0.1f;
-	glClearColor(backgroundLevel3D, backgroundLevel3D, backgroundLevel3D, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
 	// >> 3D RENDERING =================
 
 	// SHADER
@@ -33,15 +28,16 @@ void SceneView3D::Render(Project &project) {
 	shader3D.SetProjection(projection);
 	shader3D.SetCameraPos(camera.GetPos());
 
-	// Rendering models
-	const bool focusMode = MainScreen::GetComponents().sceneHierarchy.FocusModeActive();
-	for (const auto& renderModelObject : project.GetModelObjects()) {
-		if (!renderModelObject->IsVisible() || (focusMode && renderModelObject != project.GetCurrentModelObject())) continue;
-
-		renderModelObject->Render3D({shader3D, mainLight});
-		if (renderModelObject == project.GetCurrentModelObject()) renderModelObject->RenderGizmos3D({shader3D, mainLight});
+	// models are only redrawn when something they depend on changed, otherwise last frame's are reused
+	const uint64_t version = GenSceneVersion(project);
+	if (version != sceneVersion) {
+		RenderScene(project);
+		sceneVersion = version;
 	}
-	shader3D.SetModel(glm::mat4(1.0f)); // Reset Model Mat
+
+	RenderTarget::Blit(sceneCache, modelScene); // depth too, so the overlay below is still occluded by the models
+	RenderTarget::Bind(modelScene);
+	shader3D.SetModel(glm::mat4(1.0f));
 
 	// 3D Interactivity / Gizmos
 
@@ -80,6 +76,49 @@ void SceneView3D::Render(Project &project) {
 	RenderTarget::Unbind();
 }
 
+void SceneView3D::RenderScene(Project& project) {
+	RenderTarget::Bind(sceneCache);
+
+	// Clear Background
+	const float backgroundLevel3D = 0.1f;
+	glClearColor(backgroundLevel3D, backgroundLevel3D, backgroundLevel3D, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	// Rendering models
+	const bool focusMode = MainScreen::GetComponents().sceneHierarchy.FocusModeActive();
+	for (const auto& renderModelObject : project.GetModelObjects()) {
+		if (!renderModelObject->IsVisible() || (focusMode && renderModelObject != project.GetCurrentModelObject())) continue;
+
+		renderModelObject->Render3D({shader3D, mainLight});
+		if (renderModelObject == project.GetCurrentModelObject()) renderModelObject->RenderGizmos3D({shader3D, mainLight});
+	}
+	shader3D.SetModel(glm::mat4(1.0f)); // Reset Model Mat
+}
+
+// everything RenderScene draws depends on: what's drawn (visibility, focus, selection for the gizmos), mesh uploads,
+// world transforms (parents included), colors and the camera
+uint64_t SceneView3D::GenSceneVersion(Project& project) {
+	uint64_t version = 0xcbf29ce484222325ull;
+	const auto Fold = [&](const auto& value) { // FNV-1a
+		const auto* bytes = (const unsigned char*) &value;
+		for (size_t i = 0; i < sizeof(value); i++) version = (version ^ bytes[i]) * 0x100000001b3ull;
+	};
+
+	Fold(camera.CalculateViewMat());
+	Fold(camera.GetPos());
+
+	const bool focusMode = MainScreen::GetComponents().sceneHierarchy.FocusModeActive();
+	for (const auto& obj : project.GetModelObjects()) {
+		if (!obj->IsVisible() || (focusMode && obj != project.GetCurrentModelObject())) continue;
+
+		Fold(obj->GetMeshGeneration());
+		Fold(obj->GenModelMat());
+		Fold(obj->GetColor());
+		Fold(obj == project.GetCurrentModelObject());
+	}
+	return version;
+}
+
 void SceneView3D::Gui(const Project &project) {
 	ImGuiHelper::BeginComponentWindow("Model Scene");
 	{
@@ -132,6 +171,9 @@ void SceneView3D::Gui(const Project &project) {
 					Timeline& timeline = MainScreen::GetComponents().timeline;
 					draggedObj->TimelineDiffPos(timeline);
 					draggedObj->TimelineDiffEulers(timeline);
+					for (const auto param : {Enums::PARAM_X, Enums::PARAM_Y, Enums::PARAM_Z, Enums::PARAM_ROT_X, Enums::PARAM_ROT_Y, Enums::PARAM_ROT_Z}) {
+						Journal::RecordParam(draggedObj->GetID(), param, *draggedObj->GetFloatValuePtr(param));
+					}
 				}
 			}
 			ImGui::EndDragDropTarget();
@@ -156,3 +198,7 @@ void SceneView3D::PostUpdate(Project &project, float deltaTime) {
 std::vector<unsigned char> SceneView3D::GenPreviewSnapshot() {
 	return RenderTarget::SampleCentralSquare(modelScene, 64);
 }
+
+RenderTarget::PendingReadback SceneView3D::BeginPreviewSnapshot() {
+	return RenderTarget::BeginCentralSquareReadback(modelScene);
+}
@@ -20,9 +20,15 @@ public:
 	void PostUpdate(Project& project, float deltaTime);
 	void Gui(const Project& project);
 
+	[[nodiscard]] const Rectangle& GetDisplayRect() const { return displayRect; }
+
 	std::vector<unsigned char> GenPreviewSnapshot();
+	RenderTarget::PendingReadback BeginPreviewSnapshot();
 
 private:
+	void RenderScene(Project& project); // models into sceneCache
+	[[nodiscard]] uint64_t GenSceneVersion(Project& project);
+
 	constexpr static const float Z_NEAR = 0.1f, Z_FAR = 100.0f;
 
 	Shader3D shader3D = Shader3D::Read("shaders/shader.vert", "shaders/shader.frag");
@@ -36,6 +42,8 @@ private:
 	bool displayFocused = false; // updated on gui draw
 
 	RenderTarget modelScene; // TODO: calc on resize
+	RenderTarget sceneCache; // models only, modelScene is this plus the picking gizmo
+	uint64_t sceneVersion = 0; // of what's in sceneCache, see GenSceneVersion
 	glm::mat4 projection; // TODO: calc on resize
 };
 
@@ -3,9 +3,11 @@
 //
 
 #include "ObjExporter.h"
+#include "../util/TraceRecorder.h"
 
 // TODO: use buffer (since large files may cause issues)
 std::string ObjExporter::GenerateFileContents(const std::vector<std::shared_ptr<ModelObject>>& modelObjects) {
+    TRACE_SCOPE("ObjExporter::GenerateFileContents");
     std::string vertexContents, faceContents;
 
     int startVertexIndex = 1;
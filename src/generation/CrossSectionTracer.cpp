@@ -12,9 +12,11 @@
 #include "LineAnalyzer.h"
 #include "../animation/LineLerper.h"
 #include "Sampler.h"
+#include "../util/TraceRecorder.h"
 
 std::tuple<std::vector<glm::vec3>, std::vector<unsigned int>>
 CrossSectionTracer::Trace(const std::vector<glm::vec2> &points, const std::vector<glm::vec2> &pathTrace, const CrossSectionTraceData& data, TopologyCorrector* outTopologyData) {
+    TRACE_SCOPE("CrossSectionTracer::Trace");
     return Inflate(TraceSegments(points, pathTrace, data), data, outTopologyData);
 }
 
@@ -6,6 +6,7 @@
 #include "Sampler.h"
 #include "CrossSectionTracer.h"
 #include "../gl/MeshUtil.h"
+#include "../util/TraceRecorder.h"
 
 void CrossSectional::HyperParameterUI(const UIInfo& info) {
     ImGui::Text("1: %lu; 2: %lu; 4: %lu", boundPoints.size(), centralPoints.size(), crossSectionPoints.size());
@@ -15,7 +16,7 @@ void CrossSectional::HyperParameterUI(const UIInfo& info) {
             UpdateMesh();
     };
 
-    AnimatableSliderValUpdateBound("sample-length", &sampleLength, info.timeline, 0.01f, 0.5f, 0.0025f);
+    AnimatableSliderValUpdateBound(Enums::PARAM_SAMPLE_LENGTH, info.timeline, 0.01f, 0.5f, 0.0025f);
 
     ImGui::SliderInt("count-per-ring", &countPerRing, 3, 40);
     BindUIMeshUpdate();
@@ -32,7 +33,8 @@ void CrossSectional::HyperParameterUI(const UIInfo& info) {
 
 
 
-void CrossSectional::UpdateMesh() {
+MeshData CrossSectional::GenMeshData() {
+    TRACE_SCOPE("CrossSectional::GenMeshData");
 
     if (boundPoints.size() >= 2 && centralPoints.size() < 2) { // TODO: should I clear and insert???
         centralAutoGenPoints = CrossSectionTracer::AutoGenChordalAxis(boundPoints, sampleLength);
@@ -49,11 +51,10 @@ void CrossSectional::UpdateMesh() {
 
         const CrossSectionTracer::CrossSectionTraceData traceData = GenTraceData();
         const auto tempSegments = CrossSectionTracer::TraceSegments(sampled,(centralPoints.size() < 2) ? centralAutoGenPoints : Sampler::DumbSample(centralPoints, sampleLength), traceData);
-        mesh.Set(CrossSectionTracer::Inflate(tempSegments, traceData));
         segments.insert(segments.end(), tempSegments.begin(), tempSegments.end());
-    } else {
-        mesh.Set(MeshUtil::Empty());
-    };
+        return Mesh::GenData(CrossSectionTracer::Inflate(tempSegments, traceData));
+    }
+    return Mesh::GenData(MeshUtil::Empty());
 }
 
 void CrossSectional::RenderSelf2D(RenderInfo2D renderInfo) {
@@ -141,6 +142,19 @@ std::tuple<std::vector<glm::vec3>, std::vector<GLuint>> CrossSectional::GenMeshT
     return MeshUtil::Empty();
 }
 
+std::shared_ptr<const ModelObject::GeneratedState> CrossSectional::SaveGeneratedState() const {
+    auto state = std::make_shared<CrossSectionalGeneratedState>();
+    state->centralAutoGenPoints = centralAutoGenPoints;
+    state->segments = segments;
+    return state;
+}
+
+void CrossSectional::RestoreGeneratedState(const GeneratedState& state) {
+    const auto& crossSectionalState = (const CrossSectionalGeneratedState&) state;
+    centralAutoGenPoints = crossSectionalState.centralAutoGenPoints;
+    segments = crossSectionalState.segments;
+}
+
 ModelObject *CrossSectional::CopyInternals() { // FIXME: sus
 #define QUICK_COPY(a) copy->a = a
 
@@ -154,3 +168,15 @@ ModelObject *CrossSectional::CopyInternals() { // FIXME: sus
     QUICK_COPY(segments);
     return (ModelObject*) copy;
 }
+
+ModelObject* CrossSectional::CopyMeshInputs() const {
+    auto* copy = new CrossSectional(ID);
+    QUICK_COPY(sampleLength);
+    QUICK_COPY(countPerRing);
+    QUICK_COPY(wrapStart);
+    QUICK_COPY(wrapEnd);
+    QUICK_COPY(boundPoints);
+    QUICK_COPY(centralPoints);
+    QUICK_COPY(crossSectionPoints);
+    return copy;
+}
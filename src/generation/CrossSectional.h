@@ -17,7 +17,9 @@ class CrossSectional : public ModelObject {
     using ModelObject::ModelObject;
 public:
     void HyperParameterUI(const UIInfo& info) final;
-    void UpdateMesh() final;
+    MeshData GenMeshData() final; // also regenerates the auto chordal axis and trace segments
+    std::shared_ptr<const GeneratedState> SaveGeneratedState() const final;
+    void RestoreGeneratedState(const GeneratedState& state) final;
 
     void ClearAll() override;
 
@@ -63,6 +65,11 @@ private:
 
     std::vector<CrossSectionTracer::Segment> segments;
 
+    struct CrossSectionalGeneratedState : GeneratedState {
+        Vec2List centralAutoGenPoints;
+        std::vector<CrossSectionTracer::Segment> segments;
+    };
+
     glm::vec4 boundColor = {1.0f, 0.0f, 0.0f, 1.0f};
     glm::vec4 centralColor = {0.0f, 0.0f, 1.0f, 1.0f};
     glm::vec4 centralAutoGenColor = {0.0f, 1.0f, 0.0f, 1.0f};
@@ -71,6 +78,10 @@ private:
     Light lineLight = {{1.0f, 0.0f, 0.0f, 0.5f}, {-1.0f, -1.0f, -1.0f}, 1.0f};
 
     ModelObject* CopyInternals() final;
+
+public:
+    [[nodiscard]] ModelObject* Clone() const final { return new CrossSectional(*this); }
+    [[nodiscard]] ModelObject* CopyMeshInputs() const final;
 };
 
 BOOST_CLASS_VERSION(CrossSectional, 1)
@@ -9,6 +9,7 @@
 #include "../vendor/glm/ext/matrix_transform.hpp"
 #include "../project/Project.h"
 #include "../screens/MainScreen.h"
+#include "../util/Profiler.h"
 
 
 // credit: https://www.geeksforgeeks.org/check-if-two-given-line-segments-intersect/
@@ -84,6 +85,7 @@ bool Intersector::RayTriangleIntersection(Ray ray,
 
 std::optional<MeshIntersection>
 Intersector::MouseModelsIntersectionAtMousePos(Vec2 mousePos, const Project &project, const Camera &camera)  {
+	PROFILE_SCOPE("Picking");
 	Vec3 rayOrigin = camera.GetPos();
 	Vec3 rayDir = camera.GetDir();
 	constexpr float constX = 0.73f;
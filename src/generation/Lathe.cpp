@@ -12,6 +12,7 @@
 #include "../graphing/Function.h"
 #include "Collider.h"
 #include "Bezier.h"
+#include "../util/TraceRecorder.h"
 
 void Lathe::HyperParameterUI(const UIInfo& info) {
     ImGui::Text("1: %lu; 2: %lu; 3: %lu; 4: %lu", plottedPoints.size(), graphedPointsY.size(), graphedPointsZ.size(), crossSectionPoints.size());
@@ -23,15 +24,15 @@ void Lathe::HyperParameterUI(const UIInfo& info) {
 
     const auto&[timeline] = info;
 
-    AnimatableSliderValUpdateBound("scale-radius", &scaleRadius, timeline, 0.1f);
+    AnimatableSliderValUpdateBound(Enums::PARAM_SCALE_RADIUS, timeline, 0.1f);
 
-    AnimatableSliderValUpdateBound("scale-z", &scaleZ, timeline, 0.1f);
+    AnimatableSliderValUpdateBound(Enums::PARAM_SCALE_Z, timeline, 0.1f);
 
-    AnimatableSliderValUpdateBound("scale-y", &scaleY, timeline, 0.1f);
+    AnimatableSliderValUpdateBound(Enums::PARAM_SCALE_Y, timeline, 0.1f);
 
-    AnimatableSliderValUpdateBound("lean-scalar", &leanScalar, timeline, 0.0f, 1.0f);
+    AnimatableSliderValUpdateBound(Enums::PARAM_LEAN_SCALAR, timeline, 0.0f, 1.0f);
 
-    AnimatableSliderValUpdateBound("sample-length", &sampleLength, timeline, 0.01f, 0.5f, 0.0025f);
+    AnimatableSliderValUpdateBound(Enums::PARAM_SAMPLE_LENGTH, timeline, 0.01f, 0.5f, 0.0025f);
 
     ImGui::SliderInt("count-per-ring", &countPerRing, 3, 40);
     BindUIMeshUpdate();
@@ -48,6 +49,7 @@ void Lathe::HyperParameterUI(const UIInfo& info) {
 }
 
 std::tuple<std::vector<glm::vec3>, std::vector<GLuint>> Lathe::GenMeshTuple(TopologyCorrector* outTopologyData) {
+    TRACE_SCOPE("Lathe::GenMeshTuple");
 
     if (!plottedPoints.empty()) {
         const auto sampled = Sampler::DumbSample(plottedPoints, sampleLength);
@@ -74,10 +76,6 @@ std::tuple<std::vector<glm::vec3>, std::vector<GLuint>> Lathe::GenMeshTuple(Topo
     return {{}, {}};
 }
 
-void Lathe::UpdateMesh() {
-    mesh.Set(GenMeshTuple());
-}
-
 void Lathe::RenderSelf2D(RenderInfo2D renderInfo) {
     RenderCanvasLines(graphedPointsY, graphColorY, renderInfo.plot);
     RenderCanvasLines(graphedPointsZ, graphColorZ, renderInfo.plot);
@@ -116,7 +114,7 @@ void Lathe::RenderGizmos2D(RenderInfo2D renderInfo) {
                crossSectionSnapFrame.time * nearest.totalArcLength);
                 renderInfo.plot.AddPolygonOutline(point,
                         0.01f, 10, allCrossSectionSnapPointsColor);
-                renderInfo.plot.AddLines(crossSectionSnapFrame.val, {0.5f, 0.4f, 0.8f, 0.3f}, 0.005f);
+                renderInfo.plot.AddLines(crossSectionSnapFrame.val.Decode(), {0.5f, 0.4f, 0.8f, 0.3f}, 0.005f);
             }
             const RGBA currVariableCrossSectionColor = {0.9f, 0.4f, 0.8f, 0.6f};
             if (hoverRender) {
@@ -196,3 +194,21 @@ ModelObject *Lathe::CopyInternals() { // FIXME: sus
     QUICK_COPY(leanScalar);
     return (ModelObject*) copy;
 }
+
+ModelObject* Lathe::CopyMeshInputs() const {
+    auto* copy = new Lathe(ID);
+    QUICK_COPY(sampleLength);
+    QUICK_COPY(scaleRadius);
+    QUICK_COPY(scaleY);
+    QUICK_COPY(scaleZ);
+    QUICK_COPY(leanScalar);
+    QUICK_COPY(countPerRing);
+    QUICK_COPY(wrapStart);
+    QUICK_COPY(wrapEnd);
+    QUICK_COPY(plottedPoints);
+    QUICK_COPY(graphedPointsY);
+    QUICK_COPY(graphedPointsZ);
+    QUICK_COPY(crossSectionPoints);
+    QUICK_COPY(crossSectionSnapPoints);
+    return copy;
+}
@@ -20,7 +20,6 @@ class Lathe : public ModelObject {
 public:
 
     void HyperParameterUI(const UIInfo& info) final;
-    void UpdateMesh() final;
 
     void ClearAll() override;
 
@@ -35,12 +34,14 @@ public:
 
     Enums::ModelObjectType GetType() final { return Enums::LATHE; }
 
-    float* GetFloatValuePtrByLabel(const std::string& label) final {
-        if (label == "scale-radius") return &scaleRadius;
-        if (label == "scale-y") return &scaleY;
-        if (label == "scale-z") return &scaleZ;
-        if (label == "lean-scalar") return &leanScalar;
-        return ModelObject::GetFloatValuePtrByLabel(label);
+    float* GetFloatValuePtr(Enums::AnimatableParam param) final {
+        switch (param) {
+            case Enums::PARAM_SCALE_RADIUS: return &scaleRadius;
+            case Enums::PARAM_SCALE_Y: return &scaleY;
+            case Enums::PARAM_SCALE_Z: return &scaleZ;
+            case Enums::PARAM_LEAN_SCALAR: return &leanScalar;
+            default: return ModelObject::GetFloatValuePtr(param);
+        }
     }
 
 private:
@@ -74,13 +75,17 @@ private:
     Vec2List graphedPointsZ;
     Vec2List crossSectionPoints;
 
-    KeyFrameLayer<Vec2List> crossSectionSnapPoints;
+    KeyFrameLayer<PackedPolyline> crossSectionSnapPoints;
 
     RGBA plotColor = {0.0f, 0.0f, 0.0f, 1.0f};
     RGBA graphColorY = {0.0f, 0.0f, 1.0f, 1.0f};
     RGBA graphColorZ = {0.0f, 1.0f, 0.0f, 1.0f};
 
     ModelObject* CopyInternals() final;
+
+public:
+    [[nodiscard]] ModelObject* Clone() const final { return new Lathe(*this); }
+    [[nodiscard]] ModelObject* CopyMeshInputs() const final;
 };
 BOOST_CLASS_VERSION(Lathe, 1)
 
@@ -15,9 +15,104 @@
 #include "../misc/GuiStyle.h"
 #include "../screens/MainScreen.h"
 #include "../program/Program.h"
+#include "../misc/Journal.h"
+#include "../util/Profiler.h"
+#include "../util/ThreadPool.h"
+
+#include <mutex>
 
 int ModelObject::nextUniqueID = 0;
 
+void ModelObject::UpdateMesh() {
+    PROFILE_SCOPE("UpdateMesh (snapshot)"); // the meshing itself is traced on the worker, see MeshJobs::Generate
+
+    editGeneration++;
+    meshJobs.Request(std::unique_ptr<ModelObject>(CopyMeshInputs()));
+}
+
+bool ModelObject::SwapMesh() {
+    std::optional<GeneratedMesh> generated = meshJobs.Take();
+    if (!generated) return false;
+
+    PROFILE_SCOPE("SwapMesh");
+    UploadMeshData(generated->data);
+    if (generated->state) RestoreGeneratedState(*generated->state);
+    return true;
+}
+
+struct ModelObject::MeshJobs::State {
+    std::mutex mutex;
+    bool running = false; // a worker is draining this state
+
+    std::unique_ptr<ModelObject> next; // newest request the worker hasn't started yet
+    uint64_t nextSequence = 0;
+
+    std::optional<GeneratedMesh> back; // newest finished mesh
+    uint64_t backSequence = 0;
+};
+
+void ModelObject::MeshJobs::Request(std::unique_ptr<ModelObject> source) {
+    if (!state) state = std::make_shared<State>();
+
+    std::unique_ptr<ModelObject> replaced; // destroyed outside the lock
+    bool start = false;
+    {
+        std::lock_guard lock(state->mutex);
+        replaced = std::move(state->next);
+        state->next = std::move(source);
+        state->nextSequence = ++requested;
+        if (!state->running) state->running = start = true;
+    }
+    if (start) ThreadPool::Shared().Submit([state = state]() { Generate(state); });
+}
+
+void ModelObject::MeshJobs::Generate(const std::shared_ptr<State>& state) {
+    while (true) {
+        std::unique_ptr<ModelObject> source;
+        uint64_t sequence;
+        {
+            std::lock_guard lock(state->mutex);
+            if (!state->next) {
+                state->running = false;
+                return;
+            }
+            source = std::move(state->next);
+            sequence = state->nextSequence;
+        }
+
+        TRACE_SCOPE(source->GetType() == Enums::LATHE ? "UpdateMesh (Lathe)" : "UpdateMesh (CrossSectional)");
+        GeneratedMesh generated = source->GenerateMesh();
+
+        std::lock_guard lock(state->mutex);
+        if (sequence > state->backSequence) {
+            state->back = std::move(generated);
+            state->backSequence = sequence;
+        }
+    }
+}
+
+std::optional<ModelObject::GeneratedMesh> ModelObject::MeshJobs::Take() {
+    if (!state) return std::nullopt;
+
+    std::optional<GeneratedMesh> generated;
+    uint64_t sequence;
+    {
+        std::lock_guard lock(state->mutex);
+        if (!state->back) return std::nullopt;
+        generated = std::move(state->back);
+        state->back.reset();
+        sequence = state->backSequence;
+    }
+
+    if (sequence <= std::max(taken, superseded)) return std::nullopt; // a mesh applied since was requested later
+    taken = sequence;
+    return generated;
+}
+
+void ModelObject::MeshJobs::Supersede() {
+    superseded = requested;
+}
+
 void ModelObject::Render3D(RenderInfo3D renderInfo) {
     renderInfo.shader3D.SetModel(GenModelMat());
     renderInfo.mainLight.SetColor(color);
@@ -451,15 +546,32 @@ ModelObject *ModelObject::CopyRecursive() {
 }
 
 
+void ModelObject::RemapHierarchy(const std::unordered_map<const ModelObject*, ModelObject*>& originalToClone) {
+    const auto Remap = [&](const ModelObject* original) -> ModelObject* {
+        const auto it = originalToClone.find(original);
+        return it == originalToClone.end() ? nullptr : it->second;
+    };
+
+    parent = Remap(parent);
+
+    std::vector<ModelObject*> remappedChildren;
+    for (ModelObject* child : children) {
+        if (ModelObject* clone = Remap(child)) remappedChildren.push_back(clone);
+    }
+    children = remappedChildren;
+}
+
+void ModelObject::AnimatableSliderValUpdateBound(Enums::AnimatableParam param, Timeline& timeline, float min, float max, float vSpeed) {
+    const std::string label = AnimatableParams::Label(param);
+    float* ptr = GetFloatValuePtr(param);
 
-void ModelObject::AnimatableSliderValUpdateBound(const std::string& label, float* ptr, Timeline& timeline, float min, float max, float vSpeed) {
-    bool animated = timeline.HasFloatLayer(label);
+    bool animated = timeline.HasFloatLayer(param);
     ImGui::Checkbox(label.c_str(), &animated);
     if (ImGui::IsItemClicked()) {
         if (!animated) {
-            timeline.AddFloatLayer(label, *ptr);
+            timeline.AddFloatLayer(param, *ptr);
         } else {
-            timeline.RemoveFloatLayer(label);
+            timeline.RemoveFloatLayer(param);
         }
     }
 
@@ -473,8 +585,9 @@ void ModelObject::AnimatableSliderValUpdateBound(const std::string& label, float
         if (hasMax) *ptr = std::min(max, *ptr);
 
         if (animated) {
-            timeline.UpdateFloat(label, *ptr);
+            timeline.UpdateFloat(param, *ptr);
         }
+        Journal::RecordParam(GetID(), param, *ptr);
         UpdateMesh();
     }
 
@@ -523,15 +636,15 @@ void ModelObject::RenderTransformationGizmos(RenderInfo2D info) {
 }
 
 void ModelObject::TimelineDiffPos(Timeline& timeline) const {
-    timeline.TryUpdateFloat("x", modelTranslation.x);
-    timeline.TryUpdateFloat("y", modelTranslation.y);
-    timeline.TryUpdateFloat("z", modelTranslation.z);
+    timeline.TryUpdateFloat(Enums::PARAM_X, modelTranslation.x);
+    timeline.TryUpdateFloat(Enums::PARAM_Y, modelTranslation.y);
+    timeline.TryUpdateFloat(Enums::PARAM_Z, modelTranslation.z);
 }
 
 void ModelObject::TimelineDiffEulers(Timeline& timeline) const {
-    timeline.TryUpdateFloat("rot-x", eulerAngles.x);
-    timeline.TryUpdateFloat("rot-y", eulerAngles.y);
-    timeline.TryUpdateFloat("rot-z", eulerAngles.z);
+    timeline.TryUpdateFloat(Enums::PARAM_ROT_X, eulerAngles.x);
+    timeline.TryUpdateFloat(Enums::PARAM_ROT_Y, eulerAngles.y);
+    timeline.TryUpdateFloat(Enums::PARAM_ROT_Z, eulerAngles.z);
 }
 
 Undo* ModelObject::GenLineStateUndo(Enums::DrawMode drawMode) {
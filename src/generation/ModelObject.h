@@ -8,6 +8,9 @@
 #include <vector>
 #include <string>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <algorithm>
 #include "../vendor/glm/vec2.hpp"
 #include "../vendor/glm/vec4.hpp"
 #include "../vendor/glm/vec3.hpp"
@@ -33,6 +36,7 @@
 #include "../util/ImGuiHelper.h"
 #include "../util/Controls.h"
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/is_bitwise_serializable.hpp>
 
 class Timeline;
 
@@ -105,9 +109,8 @@ class ModelObject {
 public:
 
 	ModelObject() : ID(GenUniqueID()) {}
-    virtual ~ModelObject() {
-		LOG("ModelObject {ID: %i} destructing", GetID());
-	} // silences boost::serialization issue
+	explicit ModelObject(int ID) : ID(ID) {} // keeps an existing ID, for copies of an object (CopyMeshInputs)
+    virtual ~ModelObject() {} // silences boost::serialization issue
 
     virtual void HyperParameterUI(const UIInfo& info) {}
     void AuxParameterUI(const UIInfo& info) {
@@ -116,12 +119,12 @@ public:
 
         ImGui::ColorEdit3("Model color", (float *) &color, ImGuiColorEditFlags_NoInputs);
         if (ImGui::CollapsingHeader("Aux")) {
-            AnimatableSliderValUpdateBound("x", (float *) &modelTranslation.x, timeline);
-            AnimatableSliderValUpdateBound("y", (float *) &modelTranslation.y, timeline);
-            AnimatableSliderValUpdateBound("z", (float *) &modelTranslation.z, timeline);
-            AnimatableSliderValUpdateBound("rot-x", (float *) &eulerAngles.x, timeline);
-            AnimatableSliderValUpdateBound("rot-y", (float *) &eulerAngles.y, timeline);
-            AnimatableSliderValUpdateBound("rot-z", (float *) &eulerAngles.z, timeline);
+            AnimatableSliderValUpdateBound(Enums::PARAM_X, timeline);
+            AnimatableSliderValUpdateBound(Enums::PARAM_Y, timeline);
+            AnimatableSliderValUpdateBound(Enums::PARAM_Z, timeline);
+            AnimatableSliderValUpdateBound(Enums::PARAM_ROT_X, timeline);
+            AnimatableSliderValUpdateBound(Enums::PARAM_ROT_Y, timeline);
+            AnimatableSliderValUpdateBound(Enums::PARAM_ROT_Z, timeline);
         }
     }
 
@@ -129,7 +132,66 @@ public:
     virtual Enums::LineType LineTypeByMode(Enums::DrawMode drawMode) = 0;
 
     virtual void InputPoints(const EditingInfo& info);
-    virtual void UpdateMesh() {}
+    void UpdateMesh(); // after an edit -- generated on the thread pool, the current mesh stays up until SwapMesh
+    bool SwapMesh(); // main thread, once per frame: uploads the newest finished UpdateMesh, true if there was one
+    [[nodiscard]] bool IsMeshPending() const { return meshJobs.IsPending(); }
+
+    // UpdateMesh split in two so geometry can be generated on worker threads (see Project load):
+    // GenMeshData never touches GL, ApplyMeshData only uploads and must run on the main thread.
+    // Applying a mesh directly supersedes any UpdateMesh still generating, its result is dropped when it lands
+    virtual MeshData GenMeshData() { return Mesh::GenData(GenMeshTuple()); }
+    void ApplyMeshData(const MeshData& data) {
+        meshJobs.Supersede();
+        UploadMeshData(data);
+    }
+
+    // whatever else GenMeshData derives (2D overlays), kept with the mesh so it can be applied to another object
+    // (worker copies during playback, cached meshes while scrubbing)
+    struct GeneratedState {
+        virtual ~GeneratedState() = default;
+    };
+    struct GeneratedMesh {
+        MeshData data;
+        std::shared_ptr<const GeneratedState> state; // null for objects without derived state
+    };
+    GeneratedMesh GenerateMesh() { // any thread, like GenMeshData
+        MeshData data = GenMeshData();
+        return {std::move(data), SaveGeneratedState()};
+    }
+    void ApplyGeneratedMesh(const GeneratedMesh& generated) {
+        ApplyMeshData(generated.data);
+        if (generated.state) RestoreGeneratedState(*generated.state);
+    }
+    virtual std::shared_ptr<const GeneratedState> SaveGeneratedState() const { return nullptr; }
+    virtual void RestoreGeneratedState(const GeneratedState& state) {}
+
+    // UpdateMesh's double buffer: each request hands over the object's mesh inputs, the pool worker meshes them into a back
+    // buffer that SwapMesh takes from. Requests made while a generation runs replace each other, only the newest is
+    // generated next, so a slider drag never queues up stale work. Copies start idle, a clone never receives meshes
+    // requested by the original.
+    class MeshJobs {
+    public:
+        MeshJobs() = default;
+        MeshJobs(const MeshJobs&) {}
+        MeshJobs& operator=(const MeshJobs&) = delete;
+
+        void Request(std::unique_ptr<ModelObject> source); // main thread, like the rest
+        [[nodiscard]] std::optional<GeneratedMesh> Take(); // newest finished request not yet taken or superseded
+        void Supersede();
+        [[nodiscard]] bool IsPending() const { return requested > std::max(taken, superseded); }
+
+    private:
+        struct State; // shared with the worker, so it outlives an object deleted mid-generation
+        std::shared_ptr<State> state;
+        uint64_t requested = 0, taken = 0, superseded = 0;
+
+        static void Generate(const std::shared_ptr<State>& state);
+    };
+
+    // bumped by every UpdateMesh, i.e. every edit outside of timeline evaluation
+    [[nodiscard]] uint64_t GetEditGeneration() const { return editGeneration; }
+    // changes with every upload, timeline evaluation included; unique across objects and projects
+    [[nodiscard]] uint64_t GetMeshGeneration() const { return meshGeneration; }
     virtual std::tuple<std::vector<glm::vec3>, std::vector<GLuint>> GenMeshTuple(TopologyCorrector* outTopologyData = nullptr) = 0;
 
     virtual void ClearAll() {}
@@ -209,6 +271,14 @@ public:
 
     ModelObject* CopyRecursive();
 
+    // exact copy (same ID) that shares no GPU state, for handing to worker threads
+    // -- parent/children still point at the originals until RemapHierarchy is called
+    [[nodiscard]] virtual ModelObject* Clone() const = 0;
+    // bare copy with only what GenMeshData reads (points, params, sample length) -- no animator, hierarchy or GL state.
+    // What UpdateMesh hands to the worker, cheap enough to take on every edit
+    [[nodiscard]] virtual ModelObject* CopyMeshInputs() const = 0;
+    void RemapHierarchy(const std::unordered_map<const ModelObject*, ModelObject*>& originalToClone);
+
     [[nodiscard]] const std::vector<ModelObject*>& GetChildren() const { return children; };
 
     //ModelObject(const int& ID, const bool& visible, const Vec3& color) : ID(ID), visible(visible), color(color) {}
@@ -237,17 +307,21 @@ public:
 
     virtual Enums::ModelObjectType GetType() = 0;
 
-    void SetValueByLabel(const std::string& label, const float value) { *GetFloatValuePtrByLabel(label) = value; }
-
-    virtual float* GetFloatValuePtrByLabel(const std::string& label) {
-        if (label == "x") return &modelTranslation.x;
-        if (label == "y") return &modelTranslation.y;
-        if (label == "z") return &modelTranslation.z;
-        if (label == "rot-x") return &eulerAngles.x;
-        if (label == "rot-y") return &eulerAngles.y;
-        if (label == "rot-z") return &eulerAngles.z;
-        if (label == "sample-length") return &sampleLength;
-        return nullptr;
+    void SetValue(Enums::AnimatableParam param, const float value) {
+        if (float* valuePtr = GetFloatValuePtr(param)) *valuePtr = value;
+    }
+
+    virtual float* GetFloatValuePtr(Enums::AnimatableParam param) { // null for params this type doesn't have
+        switch (param) {
+            case Enums::PARAM_X: return &modelTranslation.x;
+            case Enums::PARAM_Y: return &modelTranslation.y;
+            case Enums::PARAM_Z: return &modelTranslation.z;
+            case Enums::PARAM_ROT_X: return &eulerAngles.x;
+            case Enums::PARAM_ROT_Y: return &eulerAngles.y;
+            case Enums::PARAM_ROT_Z: return &eulerAngles.z;
+            case Enums::PARAM_SAMPLE_LENGTH: return &sampleLength;
+            default: return nullptr;
+        }
     }
 
     void TimelineDiffPos(Timeline& timeline) const;
@@ -298,7 +372,7 @@ protected:
 
     static void RenderTransformationGizmos(RenderInfo2D info);
 
-    void AnimatableSliderValUpdateBound(const std::string& label, float* ptr, Timeline& timeline, float min = NAN, float max = NAN, float vSpeed = 0.025f);
+    void AnimatableSliderValUpdateBound(Enums::AnimatableParam param, Timeline& timeline, float min = NAN, float max = NAN, float vSpeed = 0.025f);
 
     virtual ModelObject* CopyInternals() = 0;
 
@@ -310,8 +384,14 @@ protected:
     glm::vec3 eulerAngles = {0.0f, 0.0f, 0.0f};
     float sampleLength = 0.1f;
     std::weak_ptr<ModelObject> internalWeakPtr;
+    uint64_t editGeneration = 0;
+    uint64_t meshGeneration = 0;
+    static inline uint64_t meshUploads = 0; // main thread
+    MeshJobs meshJobs;
+
+    void UploadMeshData(const MeshData& data) { mesh.Set(data); meshGeneration = ++meshUploads; }
 
-    bool diffed[3] {};
+    bool diffed[4] {}; // indexed by DrawMode
 
     Animator animator = {};
 
@@ -367,6 +447,9 @@ namespace boost::serialization {
     }
 }
 
+// lets binary archives write point lists as one raw block (text archives are unaffected)
+BOOST_IS_BITWISE_SERIALIZABLE(Vec2)
+
 BOOST_CLASS_VERSION(ModelObject, 1)
 
 #endif //SENIORRESEARCH_MODELOBJECT_H
@@ -77,6 +77,7 @@ void GLWindow::CreateInput() {
     glfwSetWindowUserPointer(window, static_cast<void*>(this));
     glfwSetKeyCallback(window, [](GLFWwindow* rawSelf, int key, int code, int action, int mode){
         auto self = static_cast<GLWindow*>(glfwGetWindowUserPointer(rawSelf));
+        self->input.eventCount++;
         if (key >= 0 && key <= 1024) {
             if (action == GLFW_PRESS)
                 self->input.SetKey(key, true);
@@ -87,6 +88,7 @@ void GLWindow::CreateInput() {
 
     glfwSetScrollCallback(window, [](GLFWwindow* rawSelf, double xDiff, double yDiff) {
         auto self = static_cast<GLWindow*>(glfwGetWindowUserPointer(rawSelf));
+        self->input.eventCount++;
 
         self->input.mouseScroll = (float) yDiff;
         self->input.mouseScrollHorizontal = (float) xDiff;
@@ -94,6 +96,8 @@ void GLWindow::CreateInput() {
 
     glfwSetCursorPosCallback(window, [](GLFWwindow* rawSelf, double xPos, double yPos){
         auto self = static_cast<GLWindow*>(glfwGetWindowUserPointer(rawSelf));
+        self->input.eventCount++;
+        self->input.cursorEventCount++;
 
         self->input.mouseX = (float) xPos;
         self->input.mouseY = (float) yPos;
@@ -101,6 +105,7 @@ void GLWindow::CreateInput() {
 
     glfwSetMouseButtonCallback(window, [](GLFWwindow* rawSelf, int button, int action, int mods){
         auto self = static_cast<GLWindow*>(glfwGetWindowUserPointer(rawSelf));
+        self->input.eventCount++;
         if (button == GLFW_MOUSE_BUTTON_LEFT) {
             if (action == GLFW_PRESS) {
                 self->input.mouseDown = true;
@@ -133,6 +138,7 @@ void GLWindow::CreateInput() {
 
     glfwSetWindowSizeCallback(window, [](GLFWwindow* rawSelf, int width, int height){
         auto* self = static_cast<GLWindow*>(glfwGetWindowUserPointer(rawSelf));
+        self->input.eventCount++;
 
         self->width = width;
         self->height = height;
@@ -30,6 +30,16 @@ void Input::Update() {
 
     mouseScroll = 0.0f;
     mouseScrollHorizontal = 0.0f;
+
+    eventCount = 0;
+    cursorEventCount = 0;
+}
+
+bool Input::AnyKeyDown() const {
+    for (bool down : keys) {
+        if (down) return true;
+    }
+    return false;
 }
 
 void Input::SetKey(int key, bool val) {
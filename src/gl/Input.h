@@ -21,6 +21,8 @@ public:
     bool mouseRightDown = false, mouseRightPressed = false, mouseRightUnpressed = false;
     bool mouseMiddleDown = false, mouseMiddlePressed = false, mouseMiddleUnpressed = false;
 
+    int eventCount = 0, cursorEventCount = 0; // window callbacks since the last Update, cursor motion counted in both
+
     void SetKey(int key, bool val);
 
     [[nodiscard]] bool Pressed(int key) const { return keysPressed[key]; }
@@ -28,6 +30,7 @@ public:
 
     [[nodiscard]] bool Down(int key) const { return keys[key]; }
     [[nodiscard]] bool Up(int key) const { return !keys[key]; }
+    [[nodiscard]] bool AnyKeyDown() const;
 
     void Update();
 
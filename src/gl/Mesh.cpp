@@ -5,36 +5,44 @@
 #include "Mesh.h"
 #include "Normals.h"
 #include "../generation/Intersector.h"
+#include "../util/TraceRecorder.h"
 #include <string>
 
 
-Mesh::Mesh() : Mesh(nullptr, nullptr, 0, 0) {}
-
-Mesh::Mesh(GLfloat *vertices, GLuint *indices, GLuint numOfVertices, GLuint numOfIndices) {
+Mesh::Mesh() {
     VBO = 0;
     VAO = 0;
     IBO = 0;
     indexCount = 0;
+}
+
+Mesh::Mesh(GLfloat *vertices, GLuint *indices, GLuint numOfVertices, GLuint numOfIndices) : Mesh() {
+    if (numOfVertices == 0 && numOfIndices == 0) return;
     Init(vertices, indices, numOfVertices, numOfIndices);
 }
 
+Mesh::Mesh(const Mesh& other) : Mesh() {
+    usageHint = other.usageHint;
+}
+
 Mesh::~Mesh() {
     ClearMesh();
 }
 
 void Mesh::Init(GLfloat *vertices, GLuint *indices, GLuint numOfVertices, GLuint numOfIndices) {
-    indexCount = numOfIndices;
+    if (VAO == 0) CreateBuffers();
+    Set(vertices, indices, numOfVertices, numOfIndices);
+}
 
+void Mesh::CreateBuffers() {
     glGenVertexArrays(1, &VAO);
     glBindVertexArray(VAO);
 
     glGenBuffers(1, &IBO);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * numOfIndices, nullptr, usageHint);
     glGenBuffers(1, &VBO);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices[0]) * numOfVertices, nullptr, usageHint);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*) 0);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*) (3 * sizeof(GLfloat)));
@@ -43,11 +51,10 @@ void Mesh::Init(GLfloat *vertices, GLuint *indices, GLuint numOfVertices, GLuint
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); // must unbind after VAO
-
-    Set(vertices, indices, numOfVertices, numOfIndices);
 }
 
 void Mesh::Render() const {
+    if (VAO == 0) return; // nothing uploaded yet
 
     glBindVertexArray(VAO);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
@@ -79,19 +86,33 @@ void Mesh::ClearMesh() {
 void Mesh::Set(GLfloat *vertices, GLuint *indices, GLuint numOfVertices, GLuint numOfIndices) {
 
     const std::vector<GLfloat> data = Normals::Define(vertices, indices, numOfVertices, numOfIndices);
+    Upload(data.data(), data.size(), indices, numOfIndices);
+}
+
+void Mesh::Set(const MeshData& data) {
+    Upload(data.vertexData.data(), data.vertexData.size(), data.indices.data(), data.indices.size());
+}
 
+void Mesh::Upload(const GLfloat* vertexData, size_t vertexDataCount, const GLuint* indices, GLuint numOfIndices) {
+    TRACE_SCOPE("Mesh::Upload");
+    if (VAO == 0) CreateBuffers();
     indexCount = numOfIndices;
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * numOfIndices, indices, usageHint);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * data.size(), &data[0], usageHint);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertexDataCount, vertexData, usageHint);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
+MeshData Mesh::GenData(const std::tuple<std::vector<glm::vec3>, std::vector<GLuint>>& tuple) {
+    const auto& [vertices, indices] = tuple;
+    return {Normals::Define((const GLfloat*) vertices.data(), indices.data(), vertices.size() * 3, indices.size()), indices};
+}
+
 void Mesh::Set(const std::vector<glm::vec3> &vertices, const std::vector<GLuint> &indices) {
     Set((GLfloat*) &vertices[0], (GLuint*) &indices[0], vertices.size() * 3, indices.size());
 }
@@ -11,28 +11,42 @@
 #include "../util/Util.h"
 #include "../generation/Intersector.h"
 
+// GPU-ready geometry (interleaved position + normal, indices), built without touching GL
+struct MeshData {
+    std::vector<GLfloat> vertexData;
+    std::vector<GLuint> indices;
+};
+
 class Mesh {
 public:
 
     GLenum usageHint = GL_DYNAMIC_DRAW;
 
-    Mesh();
+    Mesh(); // GL buffers are created lazily on the first Set, so meshes may be constructed off the main thread
     Mesh(GLfloat *vertices, GLuint *indices, GLuint numOfVertices, GLuint numOfIndices);
+    Mesh(const Mesh& other); // copies never share GL buffers -- they start empty and upload on their first Set
+    Mesh& operator=(const Mesh& other) = delete;
     ~Mesh();
 
     void Init(GLfloat* vertices, GLuint *indices, GLuint numOfVertices, GLuint numOfIndices);
     void Set(GLfloat* vertices, GLuint *indices, GLuint numOfVertices, GLuint numOfIndices);
     void Set(const std::tuple<std::vector<glm::vec3>, std::vector<GLuint>>& tuple);
     void Set(const std::vector<glm::vec3> &vertices, const std::vector<GLuint> &indices);
+    void Set(const MeshData& data); // upload only
     void Render() const;
     void ClearMesh();
 
+    static MeshData GenData(const std::tuple<std::vector<glm::vec3>, std::vector<GLuint>>& tuple); // any thread
+
     static std::string GenOBJ(const std::vector<glm::vec3> &vertices, const std::vector<GLuint> &indices);
     static std::string GenOBJ(const std::tuple<std::vector<glm::vec3>, std::vector<GLuint>> &tuple);
 
     static std::optional<MeshIntersection> Intersect(const std::tuple<std::vector<glm::vec3>, std::vector<GLuint>> &tuple, glm::mat4 modelMat, void* obj, Ray ray);
 
 private:
+    void CreateBuffers();
+    void Upload(const GLfloat* vertexData, size_t vertexDataCount, const GLuint* indices, GLuint numOfIndices);
+
     GLuint VAO, VBO, IBO, indexCount;
 };
 
@@ -3,13 +3,21 @@
 //
 
 #include "Mesh2D.h"
+#include "shaders/LineShader2D.h"
 #include "../util/Util.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
 Mesh2D::Mesh2D() {
     VBO = 0;
     VAO = 0;
     IBO = 0;
     indexCount = 0;
+    lineVAO = 0;
+    lineVBO = 0;
+    lineInstanceCount = 0;
     Init();
 }
 
@@ -29,7 +37,18 @@ Mesh2D::~Mesh2D() {
         VAO = 0;
     }
 
+    if (lineVBO != 0) {
+        glDeleteBuffers(1, &lineVBO);
+        lineVBO = 0;
+    }
+
+    if (lineVAO != 0) {
+        glDeleteVertexArrays(1, &lineVAO);
+        lineVAO = 0;
+    }
+
     indexCount = 0;
+    lineInstanceCount = 0;
 }
 
 void Mesh2D::Init() {
@@ -57,9 +76,33 @@ void Mesh2D::Init() {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); // must unbind after VAO
+
+
+    // polylines: no per-vertex data (corners come from gl_VertexID), every attribute advances once per instance
+    glGenVertexArrays(1, &lineVAO);
+    glBindVertexArray(lineVAO);
+
+    glGenBuffers(1, &lineVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
+    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, usageHint);
+
+    const auto InstanceAttrib = [](GLuint location, GLint size, GLenum type, GLboolean normalized, size_t offset) {
+        glVertexAttribPointer(location, size, type, normalized, sizeof(LinePoint), (GLvoid*) offset);
+        glVertexAttribDivisor(location, 1);
+        glEnableVertexAttribArray(location);
+    };
+    for (GLuint i = 0; i < 4; i++) { // prev, start, end, next
+        InstanceAttrib(i, 2, GL_FLOAT, GL_FALSE, i * sizeof(LinePoint) + offsetof(LinePoint, pos));
+    }
+    InstanceAttrib(4, 1, GL_FLOAT, GL_FALSE, 1 * sizeof(LinePoint) + offsetof(LinePoint, width)); // start
+    InstanceAttrib(5, 1, GL_FLOAT, GL_FALSE, 2 * sizeof(LinePoint) + offsetof(LinePoint, width)); // end
+    InstanceAttrib(6, 4, GL_UNSIGNED_BYTE, GL_TRUE, 1 * sizeof(LinePoint) + offsetof(LinePoint, color));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
 }
 
-void Mesh2D::Render() const {
+void Mesh2D::Render(const glm::mat4& model) const {
 
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -70,27 +113,79 @@ void Mesh2D::Render() const {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
+    if (lineInstanceCount > 0) {
+        GLint program;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+
+        LineShader2D& lineShader = LineShader();
+        lineShader.Enable();
+        lineShader.SetModel(model);
+
+        glBindVertexArray(lineVAO);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, lineInstanceCount);
+        glBindVertexArray(0);
+
+        glUseProgram(program);
+    }
+
     glDisable(GL_BLEND);
 }
 
-void Mesh2D::ImmediateRender() {
-    Set((GLfloat*)&vertexData[0], &indices[0], vertexData.size(), indices.size());
-    Render();
+void Mesh2D::ImmediateRender(const glm::mat4& model) {
+    Upload();
+    Render(model);
 }
 
-void Mesh2D::ClearingRender() {
-    Render();
+void Mesh2D::ClearingRender(const glm::mat4& model) {
+    Render(model);
     Clear();
 }
 
-void Mesh2D::ImmediateClearingRender() {
-    ImmediateRender();
+void Mesh2D::ImmediateClearingRender(const glm::mat4& model) {
+    ImmediateRender(model);
     Clear();
 }
 
+void Mesh2D::RetainedRender(const glm::mat4& model, const std::function<void(Mesh2D&)>& draw) {
+    keying = true;
+    key = 0xcbf29ce484222325ull;
+    FoldIntoKey(&scaleLines, 1);
+    draw(*this);
+    keying = false;
+
+    if (key != uploadedKey) {
+        Clear();
+        draw(*this);
+        Upload();
+        Clear();
+        uploadedKey = key;
+    }
+
+    Render(model);
+}
+
 void Mesh2D::Clear() {
     vertexData.clear();
     indices.clear();
+    linePoints.clear();
+}
+
+void Mesh2D::Upload() {
+    Set(vertexData.data(), indices.data(), vertexData.size(), indices.size());
+    SetLines(linePoints.data(), linePoints.size());
+}
+
+void Mesh2D::SetLines(const LinePoint* points, GLuint pointCount) {
+    lineInstanceCount = (pointCount >= 4) ? pointCount - 3 : 0; // each instance reads a window of four points
+
+    glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(LinePoint) * pointCount, points, usageHint);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+LineShader2D& Mesh2D::LineShader() { // shared by every Mesh2D, built on first use (needs the GL context)
+    static auto* shader = new LineShader2D(LineShader2D::Read("shaders/line2D.vert", "shaders/line2D.frag"));
+    return *shader;
 }
 
 // make args const?
@@ -108,44 +203,37 @@ void Mesh2D::Set(GLfloat *vertexDataArr, GLuint *indices, GLuint vertexDataCount
 }
 
 void Mesh2D::AddLines(const std::vector<glm::vec2> &points, glm::vec4 color, float width) {
+    if (keying) {
+        FoldIntoKey(points.data(), points.size());
+        FoldIntoKey(&color, 1);
+        FoldIntoKey(&width, 1);
+        return;
+    }
+
+    if (points.size() < 2) return; // no segments
 
     width /= scaleLines;
 
-    const GLuint startIndex = vertexData.size() / 6;
-
-    for (int i = 0; i < points.size(); i++) {
-        auto pos = points[i];
-
-        float angle = 0.0f;
-        if (i == points.size() - 1) {
-            if (i != 0) {
-                auto vec = pos - points[i - 1];
-                angle = atan2(vec.y, vec.x);
-            }
-        } else {
-            auto vec = points[i + 1] - pos;
-            angle = atan2(vec.y, vec.x);
-        }
-        angle += M_PI / 2;
-
-        const auto diff = glm::vec2(width * cos(angle), width * sin(angle));
-
-        AddVertex(pos - diff, color);
-        AddVertex(pos + diff, color);
-        if (i > 0) {
-            const GLuint p1 = (i -1) * 2 + startIndex;
-            const GLuint p2 = p1 + 1;
-            const GLuint p3 = p2 + 1;
-            const GLuint p4 = p3 + 1;
-            indices.insert(indices.end(), {
-                    p1, p2, p3,
-                    p2, p3, p4,
-            });
-        }
+    LinePoint point = {points.front(), -1.0f, {}};
+    for (int i = 0; i < 4; i++) point.color[i] = (GLubyte) std::lround(std::clamp(color[i], 0.0f, 1.0f) * 255.0f);
+
+    linePoints.push_back(point); // padding
+    point.width = width;
+    for (const auto& pos : points) {
+        point.pos = pos;
+        linePoints.push_back(point);
     }
+    point.width = -1.0f;
+    linePoints.push_back(point); // padding
 }
 
 void Mesh2D::AddQuad(glm::vec2 corner1, glm::vec2 corner2, glm::vec4 color) {
+    if (keying) {
+        const glm::vec2 corners[] = {corner1, corner2};
+        FoldIntoKey(corners, 2);
+        FoldIntoKey(&color, 1);
+        return;
+    }
     const GLuint p1 = vertexData.size() / 6;
     const GLuint p2 = p1 + 1;
     const GLuint p3 = p2 + 1;
@@ -7,9 +7,12 @@
 
 #include <glad.h>
 #include <vector>
+#include <functional>
+#include <cstdint>
 #include "../vendor/glm/glm.hpp"
 #include "../vendor/glm/gtx/vector_angle.hpp"
 
+class LineShader2D;
 
 class Mesh2D {
 public:
@@ -21,9 +24,12 @@ public:
 
     void Init();
     void Set(GLfloat* vertexDataArr, GLuint *indices, GLuint vertexDataCount, GLuint numOfIndices);
-    void Render() const;
+    // triangles (quads), then polylines on top; model must match the one set on the bound Shader2D, the polylines
+    // are drawn with their own program. Anything that has to cover the lines goes in a later Render.
+    void Render(const glm::mat4& model) const;
     void Clear();
-    void ClearingRender();
+    void ClearingRender(const glm::mat4& model);
+    // polylines are only recorded as points here, the vertex shader (line2D.vert) expands each segment and its joins
     void AddLines(const std::vector<glm::vec2> &points, glm::vec4 color, float width = 0.01f);
     void AddQuad(glm::vec2 corner1, glm::vec2 corner2, glm::vec4 color);
     void AddQuad(glm::vec2 corner1, glm::vec2 corner2, glm::vec3 color) {
@@ -31,20 +37,49 @@ public:
     }
     void AddPolygonOutline(glm::vec2 center, float rad, int pointCount, glm::vec4 color, float width = 0.01f);
 
-    void ImmediateClearingRender();
-    void ImmediateRender();
+    void ImmediateClearingRender(const glm::mat4& model);
+    void ImmediateRender(const glm::mat4& model);
+
+    // Retained layer: draw runs every frame, but its Add* calls only fold their arguments (and the line scale) into
+    // a key. The geometry is re-tessellated and re-uploaded only when the key differs from the one last uploaded.
+    void RetainedRender(const glm::mat4& model, const std::function<void(Mesh2D&)>& draw);
 
     void SetLineScale(float scale) { scaleLines = scale; }
 
     float GenScaleLineMult() { return 1.0f / scaleLines; }
 
 private:
+    // one per polyline point; each polyline is padded with a copy of its first and last point (negative width), so
+    // instance i can read points i..i+3 as (prev, start, end, next) without a segment bridging two polylines
+    struct LinePoint {
+        glm::vec2 pos;
+        float width;
+        GLubyte color[4];
+    };
+
     GLuint VAO, VBO, IBO, indexCount;
     std::vector<float> vertexData;
     std::vector<GLuint> indices;
 
+    GLuint lineVAO, lineVBO, lineInstanceCount;
+    std::vector<LinePoint> linePoints;
+
     float scaleLines = 1.0f;
 
+    bool keying = false; // inside RetainedRender's first pass
+    uint64_t key = 0, uploadedKey = 0;
+
+    template <class T>
+    void FoldIntoKey(const T* data, size_t count) { // FNV-1a over 32-bit words
+        const auto* words = (const uint32_t*) data;
+        for (size_t i = 0; i < count * sizeof(T) / sizeof(uint32_t); i++) key = (key ^ words[i]) * 0x100000001b3ull;
+    }
+
+    void Upload(); // vertexData / indices and linePoints
+    void SetLines(const LinePoint* points, GLuint pointCount);
+
+    static LineShader2D& LineShader();
+
     void AddVertex(glm::vec2 pos, glm::vec4 color) {
         vertexData.insert(vertexData.end(), {
                 pos.x, pos.y, color.r, color.g, color.b, color.a
@@ -4,11 +4,13 @@
 
 #include "Normals.h"
 #include "../vendor/glm/geometric.hpp"
+#include "../util/TraceRecorder.h"
 
 std::vector<GLfloat> Normals::Define(const GLfloat *vertices, const GLuint *indices, GLuint numOfVertices, GLuint numOfIndices) {
+    TRACE_SCOPE("Normals::Define");
 
     size_t count = numOfVertices * 2;
-    GLfloat arr[count];
+    std::vector<GLfloat> arr(count); // heap, not a VLA -- worker threads have small stacks
 
     // TODO: cleanup PLEASE
 
@@ -51,5 +53,5 @@ std::vector<GLfloat> Normals::Define(const GLfloat *vertices, const GLuint *indi
     }
 
 
-    return {arr, arr + sizeof(arr) / sizeof(GLfloat)};
+    return arr;
 }
@@ -44,30 +44,95 @@ void RenderTarget::Bind(const RenderTarget &renderTarget) {
     }
 }
 
+void RenderTarget::Blit(const RenderTarget& from, const RenderTarget& to) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, from.fboID);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, to.fboID);
+
+    const GLbitfield mask = GL_COLOR_BUFFER_BIT | ((from.hasDepth && to.hasDepth) ? GL_DEPTH_BUFFER_BIT : 0);
+    glBlitFramebuffer(0, 0, from.width, from.height, 0, 0, to.width, to.height, mask, GL_NEAREST);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+}
+
 std::vector<unsigned char> RenderTarget::SampleCentralSquare(const RenderTarget& renderTarget, int sampleCount) {
     glBindFramebuffer(GL_READ_FRAMEBUFFER, renderTarget.fboID);
 
     const int dimens = std::min(renderTarget.width, renderTarget.height);
-    unsigned char pixelBuff[dimens * dimens * 3];
-    
+    std::vector<unsigned char> pixelBuff(dimens * dimens * 3);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1); // rows are tightly packed RGB
+    glReadPixels(std::max(renderTarget.width - renderTarget.height, 0) / 2, std::max(renderTarget.height - renderTarget.width, 0) / 2,
+                 dimens, dimens, GL_RGB, GL_UNSIGNED_BYTE, pixelBuff.data());
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    return SampleSquare(pixelBuff.data(), dimens, sampleCount);
+}
+
+RenderTarget::PendingReadback RenderTarget::BeginCentralSquareReadback(const RenderTarget& renderTarget) {
+    PendingReadback readback;
+    readback.dimens = std::min(renderTarget.width, renderTarget.height);
+
+    glGenBuffers(1, &readback.pboID);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pboID);
+    glBufferData(GL_PIXEL_PACK_BUFFER, readback.dimens * readback.dimens * 3, nullptr, GL_STREAM_READ);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, renderTarget.fboID);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
     glReadPixels(std::max(renderTarget.width - renderTarget.height, 0) / 2, std::max(renderTarget.height - renderTarget.width, 0) / 2,
-                 dimens, dimens, GL_RGB, GL_UNSIGNED_BYTE, pixelBuff);
+                 readback.dimens, readback.dimens, GL_RGB, GL_UNSIGNED_BYTE, nullptr); // into the bound PBO, returns immediately
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    return readback;
+}
+
+bool RenderTarget::TryFinishReadback(PendingReadback& readback, int sampleCount, std::vector<unsigned char>& outSampled) {
+    if (readback.pboID == 0) return false;
+
+    if (readback.fence != nullptr) {
+        const GLenum status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status == GL_TIMEOUT_EXPIRED) return false;
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+    }
 
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pboID);
+    const auto* pixels = (const unsigned char*) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback.dimens * readback.dimens * 3, GL_MAP_READ_BIT);
+    if (pixels != nullptr) {
+        outSampled = SampleSquare(pixels, readback.dimens, sampleCount);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        LOG("[Warning]: could not map preview pixel buffer");
+        outSampled.clear();
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glDeleteBuffers(1, &readback.pboID);
+    readback.pboID = 0;
+    return true;
+}
+
+std::vector<unsigned char> RenderTarget::SampleSquare(const unsigned char* pixels, int dimens, int sampleCount) {
     std::vector<unsigned char> sampled;
+    sampled.reserve(sampleCount * sampleCount * 3);
 
     const float step = (float) dimens / (float) sampleCount;
     for (int j = 0; j < sampleCount; j++) {
         for (int i = 0; i < sampleCount; i++) {
             const int xPixel = (int) ((float) i * step), yPixel = (int) ((float) j * step);
             const int index = (xPixel + yPixel * dimens) * 3;
-            sampled.emplace_back(pixelBuff[index]);
-            sampled.emplace_back(pixelBuff[index + 1]);
-            sampled.emplace_back(pixelBuff[index + 2]);
+            sampled.emplace_back(pixels[index]);
+            sampled.emplace_back(pixels[index + 1]);
+            sampled.emplace_back(pixels[index + 2]);
         }
     }
 
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-
     return sampled;
 }
 
@@ -15,14 +15,27 @@ public:
 
     static void Bind(const RenderTarget& renderTarget);
     static void Unbind();
+    static void Blit(const RenderTarget& from, const RenderTarget& to); // color, and depth when both have it
 
     static std::vector<unsigned char> SampleCentralSquare(const RenderTarget& renderTarget, int sampleCount);
 
+    // non-stalling variant of SampleCentralSquare: the read is queued into a pixel buffer object and
+    // collected a few frames later once its fence has signalled
+    struct PendingReadback {
+        GLuint pboID = 0;
+        GLsync fence = nullptr;
+        int dimens = 0;
+    };
+    static PendingReadback BeginCentralSquareReadback(const RenderTarget& renderTarget);
+    static bool TryFinishReadback(PendingReadback& readback, int sampleCount, std::vector<unsigned char>& outSampled); // false while still in flight
+
     [[nodiscard]] void* GetTexture() const { return (void *) (intptr_t) GetRawTextureID(); }
 
     void ChangeDimensions(GLint width, GLint height);
     void ChangeDimensions(Vec2 vec) { ChangeDimensions((GLint) vec.x, (GLint) vec.y); }
 private:
+    static std::vector<unsigned char> SampleSquare(const unsigned char* pixels, int dimens, int sampleCount);
+
     GLuint fboID, rboID, textureID;
     GLint width, height;
     bool hasDepth;
@@ -2,6 +2,7 @@
 // Created by Tobiathan on 1/21/22.
 //
 
+#include <glad.h>
 #include "TiledTextureAtlas.h"
 #include <algorithm>
 
@@ -42,6 +43,38 @@ void TiledTextureAtlas::Generate(int tileSize, const std::vector<std::vector<uns
     Set(tileSize * cols, tileSize * rows, arr);
 }
 
+void TiledTextureAtlas::Allocate(int tileSize, int count, unsigned char placeholderShade) {
+
+    this->count = count;
+    this->tileSize = tileSize;
+
+    const int perAxis = 2048 / tileSize;
+    const int rows = std::min(count, perAxis), cols = (count / perAxis) + 1;
+
+    const int maxCount = perAxis * perAxis;
+    if (count > maxCount) {
+        LOG("[WARNING]: too many textures for texture atlas: Max=%i -- Count=%i", maxCount, count);
+    }
+
+    const int width = tileSize * cols, height = tileSize * std::max(rows, 1);
+    Set(width, height, std::vector<unsigned char>(width * height * 3, placeholderShade));
+}
+
+void TiledTextureAtlas::SetTile(int index, const std::vector<unsigned char>& texture) {
+    if (index < 0 || index >= count) return;
+    if (texture.size() != tileSize * tileSize * 3) {
+        LOG("[WARNING]: atlas tile is incorrect size!");
+        return;
+    }
+
+    const int perAxis = 2048 / tileSize;
+    const int row = index % perAxis, col = index / perAxis;
+
+    glBindTexture(GL_TEXTURE_2D, ID);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, col * tileSize, row * tileSize, tileSize, tileSize, GL_RGB, GL_UNSIGNED_BYTE, texture.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 TexCoords TiledTextureAtlas::GetCoords(int index) const {
     const int perAxis = 2048 / tileSize; // 32
     const int rows = std::min(count, perAxis), cols = (count / perAxis) + 1;
@@ -17,6 +17,8 @@ class TiledTextureAtlas : public Texture {
 public:
     TiledTextureAtlas();
     void Generate(int tileSize, const std::vector<std::vector<unsigned char>*>& textureArr);
+    void Allocate(int tileSize, int count, unsigned char placeholderShade = 40); // sized for count tiles, filled with a flat placeholder
+    void SetTile(int index, const std::vector<unsigned char>& texture); // streams one tile in via glTexSubImage2D
     TexCoords GetCoords(int index) const;
 private:
     int count, tileSize;
@@ -0,0 +1,18 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "LineShader2D.h"
+#include "../../util/Util.h"
+
+LineShader2D::LineShader2D(const char *vertexShaderSource, const char *fragmentShaderSource) : Shader(vertexShaderSource, fragmentShaderSource),
+    uniformModel(GenUniform("model"))
+{
+    Enable();
+    SetModel(glm::mat4(1.0f));
+    Disable();
+}
+
+LineShader2D LineShader2D::Read(const char *vertexShaderPath, const char *fragmentShaderPath) {
+    return {Util::ReadFile(vertexShaderPath).c_str(), Util::ReadFile(fragmentShaderPath).c_str()};
+}
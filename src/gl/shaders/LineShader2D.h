@@ -0,0 +1,24 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_LINESHADER2D_H
+#define SENIORRESEARCH_LINESHADER2D_H
+
+
+#include "Shader.h"
+
+// expands Mesh2D's polyline segments into quads on the GPU (assets/shaders/line2D.vert)
+class LineShader2D : public Shader {
+public:
+    LineShader2D(const char *vertexShaderSource, const char *fragmentShaderSource);
+
+    void SetModel(glm::mat4 model) { uniformModel.SetMat4(model); }
+
+    static LineShader2D Read(const char* vertexShaderPath, const char* fragmentShaderPath);
+private:
+    Uniform uniformModel;
+};
+
+
+#endif //SENIORRESEARCH_LINESHADER2D_H
@@ -74,9 +74,7 @@ Vec2 GraphView::GenAspectRatio() const {
     return {1.0f, guiRect.height / guiRect.width};
 }
 
-void GraphView::Render(GraphViewRenderInfo info) {
-    const auto&[plot, input] = info;
-
+void GraphView::RenderGrid(Mesh2D& plot) const {
     const Vec2 diff = GenScaleVector();
     Vec4 axisColor = {0.4f, 0.4f, 0.4f, 1.0f};
     Vec4 tickMarkColor = {0.7f, 0.7f, 0.7f, 1.0f};
@@ -99,8 +97,12 @@ void GraphView::Render(GraphViewRenderInfo info) {
             plot.AddLines({{-tickMarkSideLength, (float) i}, {tickMarkSideLength, (float) i}}, tickMarkColor, 0.003f);
         }
     }
+}
 
-    // >> GIZMOS
+void GraphView::RenderGizmos(GraphViewRenderInfo info) {
+    const auto&[plot, input] = info;
+
+    const Vec2 diff = GenScaleVector();
     const Vec2 onCanvas = MousePosToCoords(input.GetMouse());
 
     // line gizmo
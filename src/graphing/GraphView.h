@@ -28,7 +28,8 @@ struct GraphView {
     [[nodiscard]] glm::mat4 GenProjection() const;
 
     void Update(GraphViewUpdateInfo info);
-    void Render(GraphViewRenderInfo info);
+    void RenderGrid(Mesh2D& plot) const; // axes and tick marks, only changes with the view
+    void RenderGizmos(GraphViewRenderInfo info);
 
     Vec2 MousePosToCoords(Vec2 mousePos);
     Vec2 MousePosNPToCoords(Vec2 mousePosNP);
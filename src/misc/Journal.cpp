@@ -0,0 +1,709 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "Journal.h"
+#include "ProjectFile.h"
+#include "../generation/ModelObject.h"
+#include "../project/Project.h"
+#include "../project/ProjectSaver.h"
+#include "../util/ThreadPool.h"
+
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static const char JOURNAL_MAGIC[4] = {'M', 'D', 'L', 'J'};
+static constexpr uint32_t JOURNAL_VERSION = 1;
+static constexpr size_t JOURNAL_HEADER_SIZE = 8;
+static constexpr size_t RECORD_HEADER_SIZE = 8;
+
+std::string Journal::projectPath;
+std::vector<Journal::Record> Journal::pending;
+uint64_t Journal::nextSequence = 1;
+uint64_t Journal::bytesSinceCheckpoint = 0;
+float Journal::sinceFlush = 0.0f;
+float Journal::sinceCheckpoint = 0.0f;
+uint64_t Journal::structureSignature = 0;
+bool Journal::checkpointRequested = false;
+Journal::WriterState Journal::writer;
+
+// encoding helpers ===
+
+static uint32_t Fnv1a(const char* data, size_t size) {
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= (unsigned char) data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void AppendU32(std::string& out, uint32_t val) {
+	for (int i = 0; i < 4; i++) out.push_back((char) ((val >> (i * 8)) & 0xFF));
+}
+
+static void AppendU64(std::string& out, uint64_t val) {
+	for (int i = 0; i < 8; i++) out.push_back((char) ((val >> (i * 8)) & 0xFF));
+}
+
+static void AppendFloat(std::string& out, float val) {
+	uint32_t bits;
+	memcpy(&bits, &val, 4);
+	AppendU32(out, bits);
+}
+
+static void AppendString(std::string& out, const std::string& str) {
+	AppendU32(out, (uint32_t) str.size());
+	out.append(str);
+}
+
+static void AppendPoints(std::string& out, const Vec2List& points) {
+	AppendU32(out, (uint32_t) points.size());
+	for (const Vec2& point : points) {
+		AppendFloat(out, point.x);
+		AppendFloat(out, point.y);
+	}
+}
+
+// bounds-checked cursor over a record payload, ok turns false on the first overrun
+struct ByteReader {
+	const char* cursor;
+	const char* end;
+	bool ok = true;
+
+	uint64_t ReadLE(int byteCount) {
+		if (end - cursor < byteCount) {
+			ok = false;
+			return 0;
+		}
+		uint64_t val = 0;
+		for (int i = 0; i < byteCount; i++) val |= (uint64_t) (unsigned char) cursor[i] << (i * 8);
+		cursor += byteCount;
+		return val;
+	}
+
+	float ReadFloat() {
+		const auto bits = (uint32_t) ReadLE(4);
+		float val;
+		memcpy(&val, &bits, 4);
+		return val;
+	}
+
+	std::string ReadString() {
+		const uint64_t size = ReadLE(4);
+		if (!ok || (uint64_t) (end - cursor) < size) {
+			ok = false;
+			return {};
+		}
+		std::string str(cursor, size);
+		cursor += size;
+		return str;
+	}
+
+	Vec2List ReadPoints() {
+		const uint64_t count = ReadLE(4);
+		if (!ok || (uint64_t) (end - cursor) < count * 8) {
+			ok = false;
+			return {};
+		}
+		Vec2List points(count);
+		for (Vec2& point : points) {
+			point.x = ReadFloat();
+			point.y = ReadFloat();
+		}
+		return points;
+	}
+};
+
+static bool HasJournalHeader(const std::string& bytes) {
+	return bytes.size() >= JOURNAL_HEADER_SIZE && memcmp(bytes.data(), JOURNAL_MAGIC, 4) == 0 &&
+		(unsigned char) bytes[4] <= JOURNAL_VERSION && bytes[5] == 0 && bytes[6] == 0 && bytes[7] == 0;
+}
+
+static std::string JournalHeader() {
+	std::string header(JOURNAL_MAGIC, 4);
+	AppendU32(header, JOURNAL_VERSION);
+	return header;
+}
+
+// calls onRecord for every intact record, returns the offset just past the last one
+static size_t ScanRecords(const std::string& bytes, const std::function<void(const char* payload, size_t size)>& onRecord) {
+	size_t offset = JOURNAL_HEADER_SIZE;
+	while (bytes.size() - offset >= RECORD_HEADER_SIZE) {
+		ByteReader header {bytes.data() + offset, bytes.data() + offset + RECORD_HEADER_SIZE};
+		const uint64_t size = header.ReadLE(4);
+		const auto checksum = (uint32_t) header.ReadLE(4);
+
+		const char* payload = bytes.data() + offset + RECORD_HEADER_SIZE;
+		if (bytes.size() - offset - RECORD_HEADER_SIZE < size || Fnv1a(payload, size) != checksum) break; // torn write
+
+		onRecord(payload, size);
+		offset += RECORD_HEADER_SIZE + size;
+	}
+	return offset;
+}
+
+static std::string ReadFileBytes(int fd) {
+	struct stat fileStat {};
+	if (fstat(fd, &fileStat) != 0) return {};
+
+	std::string bytes(fileStat.st_size, '\0');
+	size_t filled = 0;
+	while (filled < bytes.size()) {
+		const ssize_t count = pread(fd, bytes.data() + filled, bytes.size() - filled, (off_t) filled);
+		if (count <= 0) break;
+		filled += count;
+	}
+	bytes.resize(filled);
+	return bytes;
+}
+
+static bool WriteAll(int fd, const std::string& data) {
+	const char* cursor = data.data();
+	size_t remaining = data.size();
+	while (remaining > 0) {
+		const ssize_t count = write(fd, cursor, remaining);
+		if (count <= 0) return false;
+		cursor += count;
+		remaining -= count;
+	}
+	return true;
+}
+
+static ThreadPool& JournalWriter() {
+	static ThreadPool journalWriter(1); // appends must land in order
+	return journalWriter;
+}
+
+// lifecycle ===
+
+void Journal::Attach(const std::string& newProjectPath, const Project& project) {
+	if (!projectPath.empty()) {
+		const bool sameProject = projectPath == newProjectPath; // re-opened: the files on disk are still ours
+		Submit([sameProject] { CloseOnWriter(!sameProject); });
+	}
+
+	pending.clear();
+	projectPath = newProjectPath;
+	sinceFlush = sinceCheckpoint = 0.0f;
+	bytesSinceCheckpoint = 0;
+	structureSignature = StructureSignature(project);
+
+	Submit([newProjectPath] { OpenOnWriter(newProjectPath); });
+}
+
+void Journal::Detach() {
+	if (projectPath.empty()) return;
+
+	pending.clear();
+	projectPath.clear();
+	checkpointRequested = false;
+
+	Submit([] { CloseOnWriter(true); });
+}
+
+void Journal::Update(const Project& project, float deltaTime) {
+	if (projectPath.empty()) return;
+
+	sinceFlush += deltaTime;
+	sinceCheckpoint += deltaTime;
+	if (sinceFlush < FLUSH_INTERVAL) return;
+
+	if (StructureSignature(project) != structureSignature) checkpointRequested = true; // not expressible as records
+
+	Flush();
+
+	if (checkpointRequested || bytesSinceCheckpoint >= CHECKPOINT_BYTES ||
+			(bytesSinceCheckpoint > 0 && sinceCheckpoint >= CHECKPOINT_INTERVAL)) {
+		Checkpoint(project);
+	}
+}
+
+uint64_t Journal::Flush() {
+	sinceFlush = 0.0f;
+	if (projectPath.empty() || pending.empty()) return nextSequence - 1;
+
+	Batch batch {nextSequence - 1, {}};
+	for (const Record& record : pending) {
+		const std::string payload = Encode(record);
+		AppendU32(batch.bytes, (uint32_t) payload.size());
+		AppendU32(batch.bytes, Fnv1a(payload.data(), payload.size()));
+		batch.bytes.append(payload);
+	}
+	pending.clear();
+
+	bytesSinceCheckpoint += batch.bytes.size();
+	Submit([path = projectPath, batch = std::move(batch)] { AppendOnWriter(path, batch); });
+
+	return nextSequence - 1;
+}
+
+void Journal::Finish() {
+	JournalWriter().Wait();
+}
+
+void Journal::Checkpoint(const Project& project) {
+	const uint64_t sequence = Flush();
+	auto snapshot = ProjectSaver::TakeSnapshot(project);
+
+	structureSignature = StructureSignature(project);
+	checkpointRequested = false;
+	sinceCheckpoint = 0.0f;
+	bytesSinceCheckpoint = 0;
+
+	Submit([path = projectPath, name = project.GetName(), snapshot, sequence] {
+		if (writer.projectPath != path) return;
+		if (!ProjectSaver::WriteAtomically(CheckpointPath(path), name, snapshot->serialization, sequence)) return;
+
+		writer.checkpointSequence = sequence;
+		CompactOnWriter(sequence);
+	});
+}
+
+void Journal::OnProjectWritten(const std::string& writtenPath, uint64_t sequence) {
+	Submit([writtenPath, sequence] {
+		if (writer.projectPath != writtenPath) return;
+		CompactOnWriter(sequence);
+
+		if (writer.checkpointSequence != 0 && writer.checkpointSequence <= sequence) { // project file supersedes it
+			std::error_code err;
+			std::filesystem::remove(CheckpointPath(writtenPath), err);
+			writer.checkpointSequence = 0;
+		}
+	});
+}
+
+uint64_t Journal::StructureSignature(const Project& project) {
+	uint64_t hash = 1469598103934665603ull;
+	const auto Mix = [&](uint64_t val) {
+		hash ^= val;
+		hash *= 1099511628211ull;
+	};
+
+	for (const auto& modelObject : project.GetModelObjects()) {
+		Mix((uint64_t) modelObject->GetID());
+		for (const ModelObject* child : modelObject->GetChildren()) Mix((uint64_t) child->GetID() << 32);
+	}
+	return hash;
+}
+
+// recovery ===
+
+Journal::Recovery Journal::PrepareRecovery(const std::string& recoverPath) {
+	Recovery recovery {recoverPath, 0};
+
+	std::error_code err;
+	if (std::filesystem::exists(recoverPath, err)) {
+		recovery.baseSequence = ProjectFile::ReadMetaInfo(recoverPath).journalSequence;
+	}
+
+	const std::string checkpointPath = CheckpointPath(recoverPath);
+	if (std::filesystem::exists(checkpointPath, err)) {
+		const uint64_t checkpointSequence = ProjectFile::ReadMetaInfo(checkpointPath).journalSequence;
+		if (checkpointSequence > recovery.baseSequence) {
+			LOG("recovering \"%s\" from its checkpoint", recoverPath.c_str());
+			recovery = {checkpointPath, checkpointSequence};
+		}
+	}
+
+	return recovery;
+}
+
+int Journal::Replay(const std::string& replayPath, uint64_t baseSequence, const std::vector<std::shared_ptr<ModelObject>>& modelObjects) {
+	nextSequence = std::max(nextSequence, baseSequence + 1);
+
+	const int fd = open(JournalPath(replayPath).c_str(), O_RDONLY);
+	if (fd < 0) return 0;
+	const std::string bytes = ReadFileBytes(fd);
+	close(fd);
+
+	if (!HasJournalHeader(bytes)) return 0;
+
+	std::unordered_map<int, ModelObject*> objectsByID;
+	for (const auto& modelObject : modelObjects) objectsByID[modelObject->GetID()] = modelObject.get();
+
+	int applied = 0;
+	uint64_t highestSequence = baseSequence;
+	ScanRecords(bytes, [&](const char* payload, size_t size) {
+		Record record;
+		if (!Decode(payload, size, record)) return;
+
+		highestSequence = std::max(highestSequence, record.sequence);
+		if (record.sequence <= baseSequence) return; // already contained in the project file / checkpoint
+
+		const auto it = objectsByID.find(record.objectID);
+		if (it == objectsByID.end()) return;
+
+		Apply(record, *it->second);
+		applied++;
+	});
+
+	nextSequence = std::max(nextSequence, highestSequence + 1);
+
+	if (applied > 0) {
+		LOG("recovered %i unsaved edits from \"%s\"", applied, JournalPath(replayPath).c_str());
+		checkpointRequested = true; // fold them into a checkpoint once attached
+	}
+	return applied;
+}
+
+template <class Func>
+void Journal::VisitLayer(Animator& animator, const LayerKey& layer, Func&& func) {
+	if (!layer.isFloat) {
+		func(animator.keyFrameLayers[layer.drawMode]);
+		return;
+	}
+
+	const auto param = AnimatableParams::FromLabel(layer.label);
+	if (param && animator.floatKeyFrameLayers[*param]) func(*animator.floatKeyFrameLayers[*param]);
+}
+
+void Journal::Apply(const Record& record, ModelObject& modelObject) {
+	Animator& animator = *modelObject.GetAnimatorPtr();
+	const auto param = AnimatableParams::FromLabel(record.layer.label); // float records only
+
+	switch (record.type) {
+		case RECORD_POLYLINE:
+			modelObject.GetPointsRefByMode(record.layer.drawMode) = record.points;
+			break;
+		case RECORD_PARAM:
+			if (param) modelObject.SetValue(*param, record.value);
+			break;
+		case RECORD_KEYFRAME:
+			if (record.layer.isFloat) {
+				if (!param) break;
+				auto& layer = animator.floatKeyFrameLayers[*param];
+				if (!layer) layer.emplace();
+				layer->Insert({record.value, record.time, record.blendModeID});
+			} else {
+				animator.keyFrameLayers[record.layer.drawMode].Insert({record.points, record.time, record.blendModeID});
+			}
+			break;
+		case RECORD_REMOVE:
+			VisitLayer(animator, record.layer, [&](auto& layer) { layer.RemoveAtTime(record.time); });
+			break;
+		case RECORD_MOVE:
+			VisitLayer(animator, record.layer, [&](auto& layer) {
+				if (layer.HasKeyFrameAtTime(record.time) && !layer.HasKeyFrameAtTime(record.toTime)) {
+					layer.MoveFromTimeToTime(record.time, record.toTime);
+				}
+			});
+			break;
+		case RECORD_BLEND:
+			VisitLayer(animator, record.layer, [&](auto& layer) {
+				for (auto& frame : layer.frames) {
+					if (frame.time == record.time) frame.blendModeID = record.blendModeID;
+				}
+				layer.MarkEdited();
+			});
+			break;
+		case RECORD_REMOVE_FLOAT_LAYER:
+			if (param) animator.floatKeyFrameLayers[*param].reset();
+			break;
+	}
+}
+
+// recording ===
+
+bool Journal::Touches(const Record& record, int objectID, const LayerKey& layer, float time) {
+	if (record.objectID != objectID || (!layer.isFloat && record.type == RECORD_REMOVE_FLOAT_LAYER)) return false;
+	if (record.type == RECORD_REMOVE_FLOAT_LAYER) return record.layer.label == layer.label;
+
+	const bool keyFrameRecord = record.type == RECORD_KEYFRAME || record.type == RECORD_REMOVE ||
+			record.type == RECORD_MOVE || record.type == RECORD_BLEND;
+	if (!keyFrameRecord || record.layer != layer) return false;
+
+	return record.time == time || (record.type == RECORD_MOVE && record.toTime == time);
+}
+
+// coalesces with earlier pending records where that can't change the replayed result
+void Journal::Push(Record record) {
+	if (projectPath.empty()) return;
+	record.sequence = nextSequence++;
+
+	switch (record.type) {
+		case RECORD_POLYLINE:
+		case RECORD_PARAM: // plain state, the latest value wins
+			for (Record& other : pending) {
+				if (other.type == record.type && other.objectID == record.objectID && other.layer == record.layer) {
+					other = std::move(record);
+					return;
+				}
+			}
+			break;
+		case RECORD_KEYFRAME:
+		case RECORD_BLEND: // replaces the same kind of record at the same time, unless something in between touched it
+			for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+				if (!Touches(*it, record.objectID, record.layer, record.time)) continue;
+				if (it->type == record.type && it->time == record.time) {
+					*it = std::move(record);
+					return;
+				}
+				break;
+			}
+			break;
+		case RECORD_MOVE: // chains a -> b, b -> c into a -> c (dragging emits one move per frame)
+			for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+				if (!Touches(*it, record.objectID, record.layer, record.time) &&
+						!Touches(*it, record.objectID, record.layer, record.toTime)) continue;
+
+				if (it->type == RECORD_MOVE && it->toTime == record.time) {
+					if (it->time == record.toTime) {
+						pending.erase(std::next(it).base());
+					} else {
+						it->toTime = record.toTime;
+						it->sequence = record.sequence;
+					}
+					return;
+				}
+				break;
+			}
+			break;
+		default:
+			break;
+	}
+
+	pending.push_back(std::move(record));
+}
+
+void Journal::RecordPolyline(int objectID, Enums::DrawMode drawMode, const Vec2List& points) {
+	if (projectPath.empty()) return;
+	Push({0, RECORD_POLYLINE, objectID, LayerKey::Points(drawMode), 0.0f, 0.0f, 0, 0.0f, points});
+}
+
+void Journal::RecordParam(int objectID, Enums::AnimatableParam param, float value) {
+	Push({0, RECORD_PARAM, objectID, LayerKey::Float(param), 0.0f, 0.0f, 0, value});
+}
+
+void Journal::RecordKeyFrame(int objectID, Enums::DrawMode drawMode, const KeyFrame<PackedPolyline>& frame) {
+	if (projectPath.empty()) return;
+	Push({0, RECORD_KEYFRAME, objectID, LayerKey::Points(drawMode), frame.time, 0.0f, frame.blendModeID, 0.0f, frame.val.Decode()});
+}
+
+void Journal::RecordKeyFrame(int objectID, Enums::AnimatableParam param, const KeyFrame<float>& frame) {
+	Push({0, RECORD_KEYFRAME, objectID, LayerKey::Float(param), frame.time, 0.0f, frame.blendModeID, frame.val});
+}
+
+void Journal::RecordRemove(int objectID, const LayerKey& layer, float time) {
+	Push({0, RECORD_REMOVE, objectID, layer, time});
+}
+
+void Journal::RecordMove(int objectID, const LayerKey& layer, float fromTime, float toTime) {
+	if (fromTime == toTime) return;
+	Push({0, RECORD_MOVE, objectID, layer, fromTime, toTime});
+}
+
+void Journal::RecordBlend(int objectID, const LayerKey& layer, float time, int blendModeID) {
+	Push({0, RECORD_BLEND, objectID, layer, time, 0.0f, blendModeID});
+}
+
+void Journal::RecordRemoveFloatLayer(int objectID, Enums::AnimatableParam param) {
+	Push({0, RECORD_REMOVE_FLOAT_LAYER, objectID, LayerKey::Float(param)});
+}
+
+// [sequence:u64][type:u8][objectID:i32] then per type:
+//   POLYLINE [drawMode:u8][points]           PARAM [label][value:f32]
+//   KEYFRAME [layer][time:f32][blendID:i32][value:f32 | points]
+//   REMOVE [layer][time:f32]    MOVE [layer][from:f32][to:f32]    BLEND [layer][time:f32][blendID:i32]
+//   REMOVE_FLOAT_LAYER [label]
+// layer = [isFloat:u8][drawMode:u8][label], points = [count:u32] count x [x:f32][y:f32]
+std::string Journal::Encode(const Record& record) {
+	std::string out;
+	out.reserve(32 + record.layer.label.size() + record.points.size() * 8);
+
+	AppendU64(out, record.sequence);
+	out.push_back((char) record.type);
+	AppendU32(out, (uint32_t) record.objectID);
+
+	const auto AppendLayer = [&] {
+		out.push_back((char) record.layer.isFloat);
+		out.push_back((char) record.layer.drawMode);
+		AppendString(out, record.layer.label);
+	};
+
+	switch (record.type) {
+		case RECORD_POLYLINE:
+			out.push_back((char) record.layer.drawMode);
+			AppendPoints(out, record.points);
+			break;
+		case RECORD_PARAM:
+			AppendString(out, record.layer.label);
+			AppendFloat(out, record.value);
+			break;
+		case RECORD_KEYFRAME:
+			AppendLayer();
+			AppendFloat(out, record.time);
+			AppendU32(out, (uint32_t) record.blendModeID);
+			if (record.layer.isFloat) AppendFloat(out, record.value);
+			else AppendPoints(out, record.points);
+			break;
+		case RECORD_REMOVE:
+			AppendLayer();
+			AppendFloat(out, record.time);
+			break;
+		case RECORD_MOVE:
+			AppendLayer();
+			AppendFloat(out, record.time);
+			AppendFloat(out, record.toTime);
+			break;
+		case RECORD_BLEND:
+			AppendLayer();
+			AppendFloat(out, record.time);
+			AppendU32(out, (uint32_t) record.blendModeID);
+			break;
+		case RECORD_REMOVE_FLOAT_LAYER:
+			AppendString(out, record.layer.label);
+			break;
+	}
+
+	return out;
+}
+
+bool Journal::Decode(const char* data, size_t size, Record& outRecord) {
+	ByteReader reader {data, data + size};
+
+	outRecord.sequence = reader.ReadLE(8);
+	outRecord.type = (RecordType) reader.ReadLE(1);
+	outRecord.objectID = (int) (uint32_t) reader.ReadLE(4);
+
+	const auto ReadLayer = [&] {
+		outRecord.layer.isFloat = reader.ReadLE(1) != 0;
+		outRecord.layer.drawMode = (Enums::DrawMode) reader.ReadLE(1);
+		outRecord.layer.label = reader.ReadString();
+	};
+
+	switch (outRecord.type) {
+		case RECORD_POLYLINE:
+			outRecord.layer.drawMode = (Enums::DrawMode) reader.ReadLE(1);
+			outRecord.points = reader.ReadPoints();
+			break;
+		case RECORD_PARAM:
+			outRecord.layer = {true, Enums::MODE_PLOT, reader.ReadString()};
+			outRecord.value = reader.ReadFloat();
+			break;
+		case RECORD_KEYFRAME:
+			ReadLayer();
+			outRecord.time = reader.ReadFloat();
+			outRecord.blendModeID = (int) (uint32_t) reader.ReadLE(4);
+			if (outRecord.layer.isFloat) outRecord.value = reader.ReadFloat();
+			else outRecord.points = reader.ReadPoints();
+			break;
+		case RECORD_REMOVE:
+			ReadLayer();
+			outRecord.time = reader.ReadFloat();
+			break;
+		case RECORD_MOVE:
+			ReadLayer();
+			outRecord.time = reader.ReadFloat();
+			outRecord.toTime = reader.ReadFloat();
+			break;
+		case RECORD_BLEND:
+			ReadLayer();
+			outRecord.time = reader.ReadFloat();
+			outRecord.blendModeID = (int) (uint32_t) reader.ReadLE(4);
+			break;
+		case RECORD_REMOVE_FLOAT_LAYER:
+			outRecord.layer = {true, Enums::MODE_PLOT, reader.ReadString()};
+			break;
+		default:
+			return false; // written by a newer version
+	}
+
+	return reader.ok && outRecord.layer.drawMode >= Enums::MODE_PLOT && outRecord.layer.drawMode <= Enums::MODE_CROSS_SECTION;
+}
+
+// writer thread ===
+
+void Journal::Submit(std::function<void()> task) {
+	JournalWriter().Submit(std::move(task));
+}
+
+void Journal::OpenOnWriter(const std::string& openPath) {
+	writer = {};
+	writer.projectPath = openPath;
+
+	const std::string path = JournalPath(openPath);
+	const int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		LOG("[Warning]: could not open journal \"%s\"", path.c_str());
+		return;
+	}
+
+	const std::string bytes = ReadFileBytes(fd);
+	if (HasJournalHeader(bytes)) {
+		uint64_t lastSequence = 0;
+		const size_t validEnd = ScanRecords(bytes, [&](const char* payload, size_t size) {
+			lastSequence = std::max(lastSequence, ByteReader {payload, payload + size}.ReadLE(8));
+		});
+
+		if (validEnd < bytes.size() && ftruncate(fd, (off_t) validEnd) != 0) { // drop a torn tail so appends stay reachable
+			LOG("[Warning]: could not truncate journal \"%s\"", path.c_str());
+		}
+		if (validEnd > JOURNAL_HEADER_SIZE) {
+			writer.batches.push_back({lastSequence, bytes.substr(JOURNAL_HEADER_SIZE, validEnd - JOURNAL_HEADER_SIZE)});
+		}
+	} else if (ftruncate(fd, 0) != 0 || !WriteAll(fd, JournalHeader())) {
+		LOG("[Warning]: could not initialize journal \"%s\"", path.c_str());
+	}
+	fsync(fd);
+	close(fd);
+
+	writer.fd = open(path.c_str(), O_WRONLY | O_APPEND);
+
+	std::error_code err;
+	const std::string checkpointPath = CheckpointPath(openPath);
+	if (std::filesystem::exists(checkpointPath, err)) {
+		writer.checkpointSequence = ProjectFile::ReadMetaInfo(checkpointPath).journalSequence;
+	}
+}
+
+void Journal::AppendOnWriter(const std::string& appendPath, const Batch& batch) {
+	if (writer.projectPath != appendPath || writer.fd < 0) return;
+
+	if (!WriteAll(writer.fd, batch.bytes) || fsync(writer.fd) != 0) {
+		LOG("[Warning]: could not append to journal \"%s\"", JournalPath(appendPath).c_str());
+	}
+	writer.batches.push_back(batch);
+}
+
+// rewrites the journal without the batches already contained in a project file / checkpoint
+void Journal::CompactOnWriter(uint64_t sequence) {
+	const auto removed = std::erase_if(writer.batches, [sequence](const Batch& batch) { return batch.lastSequence <= sequence; });
+	if (removed == 0 || writer.fd < 0) return;
+
+	const std::string path = JournalPath(writer.projectPath);
+	const std::string tempPath = path + ".tmp";
+
+	std::string bytes = JournalHeader();
+	for (const Batch& batch : writer.batches) bytes.append(batch.bytes);
+
+	const int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	const bool written = fd >= 0 && WriteAll(fd, bytes) && fsync(fd) == 0;
+	if (fd >= 0) close(fd);
+
+	std::error_code err;
+	if (written) std::filesystem::rename(tempPath, path, err);
+	if (!written || err) { // the old journal is still complete, just longer than needed
+		std::filesystem::remove(tempPath, err);
+		return;
+	}
+
+	close(writer.fd);
+	writer.fd = open(path.c_str(), O_WRONLY | O_APPEND);
+}
+
+void Journal::CloseOnWriter(bool discard) {
+	if (writer.fd >= 0) close(writer.fd);
+
+	if (discard && !writer.projectPath.empty()) {
+		std::error_code err;
+		std::filesystem::remove(JournalPath(writer.projectPath), err);
+		std::filesystem::remove(CheckpointPath(writer.projectPath), err);
+	}
+
+	writer = {};
+}
@@ -0,0 +1,145 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_JOURNAL_H
+#define SENIORRESEARCH_JOURNAL_H
+
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include "../util/Includes.h"
+#include "../animation/KeyFrame.h"
+#include "../animation/AnimatableParams.h"
+
+class ModelObject;
+class Project;
+class Animator;
+
+// Crash-safe autosave: an append-only "<project>.journal" of small edit records next to the project file.
+//  - edits are recorded on the main thread, coalesced, and handed to a writer thread every FLUSH_INTERVAL
+//    which appends + fsyncs them, so an autosave costs only the size of the edits
+//  - every record carries a sequence number, project files and checkpoints store the last sequence they contain
+//  - a checkpoint ("<project>.ckpt", full snapshot) is written every CHECKPOINT_INTERVAL / CHECKPOINT_BYTES and on
+//    structural changes (objects added, removed or re-parented), after which the journal is compacted
+//  - opening a project replays every record newer than the project file (or its checkpoint, when that is newer)
+// Journal file: [magic:4][version:u32] then records of [payloadSize:u32][fnv1a(payload):u32][payload],
+// a torn or corrupt tail is dropped on replay.
+// Untitled projects are not journaled, recording starts once a project has a path.
+class Journal {
+public:
+	struct LayerKey {
+		bool isFloat = false;
+		Enums::DrawMode drawMode = Enums::MODE_PLOT; // when !isFloat
+		std::string label; // when isFloat, AnimatableParams label
+
+		static LayerKey Points(Enums::DrawMode drawMode) { return {false, drawMode, ""}; }
+		static LayerKey Float(Enums::AnimatableParam param) { return {true, Enums::MODE_PLOT, AnimatableParams::Label(param)}; }
+
+		bool operator==(const LayerKey& other) const = default;
+	};
+
+	struct Recovery {
+		std::string sourcePath; // project file, or its checkpoint when that is newer
+		uint64_t baseSequence = 0;
+	};
+
+	// main thread
+	static void Attach(const std::string& projectPath, const Project& project);
+	static void Detach(); // discards the journal (clean shutdown / switching projects)
+	static void Update(const Project& project, float deltaTime);
+	static uint64_t Flush(); // hands pending records to the writer, returns the last recorded sequence
+	static void Finish(); // blocks until the writer is idle
+
+	// any thread -- the project file at projectPath now contains every record up to sequence
+	static void OnProjectWritten(const std::string& projectPath, uint64_t sequence);
+
+	static Recovery PrepareRecovery(const std::string& projectPath);
+	static int Replay(const std::string& projectPath, uint64_t baseSequence, const std::vector<std::shared_ptr<ModelObject>>& modelObjects);
+
+	// recording, no-ops while detached
+	static void RecordPolyline(int objectID, Enums::DrawMode drawMode, const Vec2List& points);
+	static void RecordParam(int objectID, Enums::AnimatableParam param, float value);
+	static void RecordKeyFrame(int objectID, Enums::DrawMode drawMode, const KeyFrame<PackedPolyline>& frame);
+	static void RecordKeyFrame(int objectID, Enums::AnimatableParam param, const KeyFrame<float>& frame);
+	static void RecordRemove(int objectID, const LayerKey& layer, float time);
+	static void RecordMove(int objectID, const LayerKey& layer, float fromTime, float toTime);
+	static void RecordBlend(int objectID, const LayerKey& layer, float time, int blendModeID);
+	static void RecordRemoveFloatLayer(int objectID, Enums::AnimatableParam param);
+
+	static constexpr float FLUSH_INTERVAL = 0.5f;
+	static constexpr float CHECKPOINT_INTERVAL = 120.0f;
+	static constexpr uint64_t CHECKPOINT_BYTES = 1 << 20;
+
+private:
+	enum RecordType : uint8_t {
+		RECORD_POLYLINE = 1,
+		RECORD_PARAM,
+		RECORD_KEYFRAME,
+		RECORD_REMOVE,
+		RECORD_MOVE,
+		RECORD_BLEND,
+		RECORD_REMOVE_FLOAT_LAYER,
+	};
+
+	struct Record {
+		uint64_t sequence = 0;
+		RecordType type = RECORD_POLYLINE;
+		int objectID = -1;
+		LayerKey layer; // POLYLINE: drawMode, PARAM: label
+		float time = 0.0f, toTime = 0.0f;
+		int blendModeID = 0;
+		float value = 0.0f;
+		Vec2List points;
+	};
+
+	struct Batch {
+		uint64_t lastSequence;
+		std::string bytes;
+	};
+
+	// only touched by tasks on the writer thread
+	struct WriterState {
+		std::string projectPath;
+		int fd = -1;
+		std::vector<Batch> batches; // everything in the journal file, kept for compaction
+		uint64_t checkpointSequence = 0;
+	};
+
+	static void Push(Record record);
+	static bool Touches(const Record& record, int objectID, const LayerKey& layer, float time);
+	static void Checkpoint(const Project& project);
+	static uint64_t StructureSignature(const Project& project);
+
+	static std::string Encode(const Record& record);
+	static bool Decode(const char* data, size_t size, Record& outRecord);
+	static void Apply(const Record& record, ModelObject& modelObject);
+	template <class Func>
+	static void VisitLayer(Animator& animator, const LayerKey& layer, Func&& func); // skips missing float layers
+
+	static void Submit(std::function<void()> task);
+	static void OpenOnWriter(const std::string& projectPath);
+	static void AppendOnWriter(const std::string& projectPath, const Batch& batch);
+	static void CompactOnWriter(uint64_t sequence);
+	static void CloseOnWriter(bool discard);
+
+	static std::string JournalPath(const std::string& projectPath) { return projectPath + ".journal"; }
+	static std::string CheckpointPath(const std::string& projectPath) { return projectPath + ".ckpt"; }
+
+	// main thread state
+	static std::string projectPath; // empty while detached
+	static std::vector<Record> pending;
+	static uint64_t nextSequence;
+	static uint64_t bytesSinceCheckpoint;
+	static float sinceFlush, sinceCheckpoint;
+	static uint64_t structureSignature;
+	static bool checkpointRequested;
+
+	static WriterState writer;
+};
+
+
+#endif //SENIORRESEARCH_JOURNAL_H
@@ -0,0 +1,350 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "ProjectFile.h"
+#include "../util/TraceRecorder.h"
+
+#include <bit>
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+// section payloads are raw host-order arrays, so the format is only defined for little-endian hosts
+static_assert(std::endian::native == std::endian::little, "ProjectFile assumes a little-endian host");
+
+const char ProjectFile::MAGIC[MAGIC_SIZE] = {'\x89', 'M', 'D', 'L', '\r', '\n', '\x1a', '\n'};
+
+// read-only view over an in-memory buffer, lets archives parse straight out of the file bytes
+struct MemoryStreamBuf : std::streambuf {
+	MemoryStreamBuf(const char* data, size_t size) {
+		char* begin = const_cast<char*>(data);
+		setg(begin, begin, begin + size);
+	}
+};
+
+static void AppendU32(std::string& out, uint32_t val) {
+	for (int i = 0; i < 4; i++) out.push_back((char) ((val >> (i * 8)) & 0xFF));
+}
+
+static void AppendU64(std::string& out, uint64_t val) {
+	for (int i = 0; i < 8; i++) out.push_back((char) ((val >> (i * 8)) & 0xFF));
+}
+
+static uint64_t ReadLE(const char* data, int byteCount) {
+	uint64_t val = 0;
+	for (int i = 0; i < byteCount; i++) val |= (uint64_t) (unsigned char) data[i] << (i * 8);
+	return val;
+}
+
+// reads exactly size bytes at offset, retrying on short reads
+static bool PRead(int fd, char* out, size_t size, uint64_t offset) {
+	while (size > 0) {
+		const ssize_t count = pread(fd, out, size, (off_t) offset);
+		if (count <= 0) return false;
+		out += count;
+		size -= count;
+		offset += count;
+	}
+	return true;
+}
+
+// write + fsync, so a following rename can not expose a half-written file after a power loss
+static bool WriteDurably(const std::string& path, const std::string& data) {
+	const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) return false;
+
+	const char* cursor = data.data();
+	size_t remaining = data.size();
+	while (remaining > 0) {
+		const ssize_t count = write(fd, cursor, remaining);
+		if (count <= 0) {
+			close(fd);
+			return false;
+		}
+		cursor += count;
+		remaining -= count;
+	}
+
+	const bool synced = fsync(fd) == 0;
+	return close(fd) == 0 && synced;
+}
+
+bool ProjectFile::Write(const std::string& path, const std::string& name, Serialization serialization, uint64_t journalSequence) {
+	TRACE_SCOPE("ProjectFile::Write");
+	MetaInfo meta;
+	meta.name = name;
+	meta.objectCount = (int) serialization.order.size();
+	meta.img = std::move(serialization.img);
+	serialization.img.clear(); // preview is carried by the meta section only
+
+	const int previewSize = 64;
+	if (meta.img.size() == previewSize * previewSize * 3) {
+		meta.previewWidth = meta.previewHeight = previewSize;
+	} else {
+		meta.img.clear();
+	}
+
+	const std::string metaBytes = EncodeMeta(meta);
+
+	std::ostringstream sceneStream(std::ios::binary);
+	{
+		boost::archive::binary_oarchive oa(sceneStream);
+		oa << serialization;
+	}
+	const std::string scene = sceneStream.str();
+
+	std::string journalBytes;
+	AppendU64(journalBytes, journalSequence);
+
+	const std::vector<Section> sections = {
+			{SECTION_META, 0, metaBytes.size()},
+			{SECTION_JOURNAL, 0, journalBytes.size()},
+			{SECTION_SCENE, 0, scene.size()},
+	};
+
+	std::string file;
+	file.reserve(HEADER_SIZE + sections.size() * SECTION_ENTRY_SIZE + metaBytes.size() + scene.size());
+
+	file.append(MAGIC, MAGIC_SIZE);
+	AppendU32(file, FORMAT_VERSION);
+	AppendU32(file, (uint32_t) sections.size());
+
+	uint64_t offset = HEADER_SIZE + sections.size() * SECTION_ENTRY_SIZE;
+	for (const Section& section : sections) {
+		AppendU32(file, section.type);
+		AppendU32(file, 0);
+		AppendU64(file, offset);
+		AppendU64(file, section.size);
+		offset += section.size;
+	}
+
+	file.append(metaBytes);
+	file.append(journalBytes);
+	file.append(scene);
+
+	const bool written = WriteDurably(path, file);
+	if (!written) LOG("[Warning]: could not write \"%s\"", path.c_str());
+	return written;
+}
+
+Serialization ProjectFile::Read(const std::string& path) {
+	TRACE_SCOPE("ProjectFile::Read");
+	const std::vector<char> bytes = ReadWholeFile(path);
+
+	if (!HasMagic(bytes.data(), bytes.size())) {
+		return ReadTextArchive(bytes.data(), bytes.size(), false);
+	}
+
+	std::vector<Section> sections;
+	Serialization serialization;
+	if (!ParseSections(bytes.data(), bytes.size(), sections)) return serialization;
+
+	const Section* scene = FindSection(sections, SECTION_SCENE);
+	if (scene == nullptr) {
+		LOG("[Warning]: project file has no scene section!");
+		return serialization;
+	}
+
+	MemoryStreamBuf sceneBuf(bytes.data() + scene->offset, scene->size);
+	boost::archive::binary_iarchive ia(sceneBuf);
+	ia >> serialization;
+
+	if (const Section* metaSection = FindSection(sections, SECTION_META)) {
+		MetaInfo meta;
+		if (DecodeMeta(bytes.data() + metaSection->offset, metaSection->size, meta)) serialization.img = std::move(meta.img);
+	}
+
+	return serialization;
+}
+
+ProjectFile::MetaInfo ProjectFile::ReadMetaInfo(const std::string& path) {
+	MetaInfo meta;
+
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		LOG("[Warning]: could not open \"%s\"", path.c_str());
+		return meta;
+	}
+
+	struct stat fileStat {};
+	char header[HEADER_SIZE];
+	uint32_t sectionCount = 0;
+
+	const bool binary = fstat(fd, &fileStat) == 0 &&
+			PRead(fd, header, HEADER_SIZE, 0) && HasMagic(header, HEADER_SIZE);
+
+	if (!binary) { // legacy text archive, the preview sits at the start of the archive
+		close(fd);
+		const std::vector<char> bytes = ReadWholeFile(path);
+		if (bytes.empty()) return meta;
+
+		Serialization serialization = ReadTextArchive(bytes.data(), bytes.size(), true);
+		meta.previewWidth = meta.previewHeight = 64;
+		meta.img = std::move(serialization.img);
+		return meta;
+	}
+
+	std::vector<Section> sections;
+	if (ParseHeader(header, HEADER_SIZE, sectionCount) && HEADER_SIZE + (uint64_t) sectionCount * SECTION_ENTRY_SIZE <= (uint64_t) fileStat.st_size) {
+		std::vector<char> table(sectionCount * SECTION_ENTRY_SIZE);
+		if (PRead(fd, table.data(), table.size(), HEADER_SIZE)) {
+			ParseSectionTable(table.data(), sectionCount, (uint64_t) fileStat.st_size, sections);
+		}
+	}
+
+	if (const Section* metaSection = FindSection(sections, SECTION_META)) {
+		std::vector<char> metaBytes(metaSection->size);
+		if (PRead(fd, metaBytes.data(), metaBytes.size(), metaSection->offset)) {
+			DecodeMeta(metaBytes.data(), metaBytes.size(), meta);
+		}
+	}
+
+	if (const Section* journalSection = FindSection(sections, SECTION_JOURNAL); journalSection && journalSection->size >= 8) {
+		char sequence[8];
+		if (PRead(fd, sequence, 8, journalSection->offset)) meta.journalSequence = ReadLE(sequence, 8);
+	}
+
+	close(fd);
+	return meta;
+}
+
+bool ProjectFile::HasMagic(const char* data, size_t size) {
+	return size >= MAGIC_SIZE && memcmp(data, MAGIC, MAGIC_SIZE) == 0;
+}
+
+bool ProjectFile::ParseHeader(const char* data, size_t size, uint32_t& outSectionCount) {
+	if (size < HEADER_SIZE) {
+		LOG("[Warning]: project file header is truncated!");
+		return false;
+	}
+
+	const auto formatVersion = (uint32_t) ReadLE(data + MAGIC_SIZE, 4);
+	if (formatVersion > FORMAT_VERSION) {
+		LOG("[Warning]: project file version %u is newer than supported (%u)!", formatVersion, FORMAT_VERSION);
+		return false;
+	}
+
+	outSectionCount = (uint32_t) ReadLE(data + MAGIC_SIZE + 4, 4);
+	return true;
+}
+
+bool ProjectFile::ParseSectionTable(const char* data, uint32_t sectionCount, uint64_t fileSize, std::vector<Section>& outSections) {
+	outSections.clear();
+	outSections.reserve(sectionCount);
+	for (uint32_t i = 0; i < sectionCount; i++) {
+		const char* entry = data + i * SECTION_ENTRY_SIZE;
+		Section section {
+			(uint32_t) ReadLE(entry, 4),
+			ReadLE(entry + 8, 8),
+			ReadLE(entry + 16, 8),
+		};
+		if (section.offset > fileSize || section.size > fileSize - section.offset) {
+			LOG("[Warning]: project file section %u is out of bounds!", section.type);
+			outSections.clear();
+			return false;
+		}
+		outSections.push_back(section);
+	}
+
+	return true;
+}
+
+bool ProjectFile::ParseSections(const char* data, size_t size, std::vector<Section>& outSections) {
+	uint32_t sectionCount = 0;
+	if (!ParseHeader(data, size, sectionCount)) return false;
+
+	if (size < HEADER_SIZE + (uint64_t) sectionCount * SECTION_ENTRY_SIZE) {
+		LOG("[Warning]: project file section table is truncated!");
+		return false;
+	}
+
+	return ParseSectionTable(data + HEADER_SIZE, sectionCount, size, outSections);
+}
+
+const ProjectFile::Section* ProjectFile::FindSection(const std::vector<Section>& sections, SectionType type) {
+	for (const Section& section : sections) {
+		if (section.type == type) return &section;
+	}
+	return nullptr;
+}
+
+// [nameLength:u32][name][objectCount:i32][previewWidth:u32][previewHeight:u32][preview RGB bytes]
+std::string ProjectFile::EncodeMeta(const MetaInfo& meta) {
+	std::string out;
+	out.reserve(16 + meta.name.size() + meta.img.size());
+
+	AppendU32(out, (uint32_t) meta.name.size());
+	out.append(meta.name);
+	AppendU32(out, (uint32_t) meta.objectCount);
+	AppendU32(out, (uint32_t) meta.previewWidth);
+	AppendU32(out, (uint32_t) meta.previewHeight);
+	out.append((const char*) meta.img.data(), meta.img.size());
+
+	return out;
+}
+
+bool ProjectFile::DecodeMeta(const char* data, size_t size, MetaInfo& outMeta) {
+	if (size < 4) return false;
+	const uint64_t nameLength = ReadLE(data, 4);
+	if (size < 16 + nameLength) return false;
+
+	const char* cursor = data + 4;
+	outMeta.name.assign(cursor, nameLength);
+	cursor += nameLength;
+	outMeta.objectCount = (int) (uint32_t) ReadLE(cursor, 4);
+	outMeta.previewWidth = (int) ReadLE(cursor + 4, 4);
+	outMeta.previewHeight = (int) ReadLE(cursor + 8, 4);
+	cursor += 12;
+
+	const size_t previewSize = (size_t) outMeta.previewWidth * outMeta.previewHeight * 3;
+	if ((size_t) (data + size - cursor) < previewSize) {
+		outMeta.img.clear();
+		return false;
+	}
+	outMeta.img.assign(cursor, cursor + previewSize);
+
+	return true;
+}
+
+std::vector<char> ProjectFile::ReadWholeFile(const std::string& path) {
+	std::vector<char> bytes;
+
+	std::ifstream ifs(path, std::ios::binary);
+	if (!ifs) {
+		LOG("[Warning]: could not open \"%s\"", path.c_str());
+		return bytes;
+	}
+
+	std::error_code err;
+	const auto fileSize = std::filesystem::file_size(path, err);
+	if (err) return bytes;
+
+	bytes.resize(fileSize);
+	ifs.read(bytes.data(), (std::streamsize) fileSize);
+	bytes.resize(ifs.gcount());
+
+	return bytes;
+}
+
+Serialization ProjectFile::ReadTextArchive(const char* data, size_t size, bool metaOnly) {
+	Serialization serialization;
+
+	MemoryStreamBuf buf(data, size);
+	std::istream is(&buf);
+
+	Serialization::SetReadMetaOnly(metaOnly);
+	boost::archive::text_iarchive ia(is);
+	ia >> serialization;
+	Serialization::SetReadMetaOnly(false);
+
+	return serialization;
+}
@@ -0,0 +1,71 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_PROJECTFILE_H
+#define SENIORRESEARCH_PROJECTFILE_H
+
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Serialization.h"
+
+// On-disk container for .mdl projects:
+//   [magic:8][formatVersion:u32][sectionCount:u32]
+//   sectionCount x [type:u32][reserved:u32][offset:u64][size:u64]
+//   section payloads...
+// All header fields are little-endian. The meta section is written directly after the section table so the
+// open dialog can fetch it with a couple of small positioned reads. The scene section is a boost binary archive
+// (Vec2 / float keyframe arrays are written as raw blocks).
+// Files without the magic are treated as legacy boost text archives.
+class ProjectFile {
+public:
+	struct MetaInfo {
+		std::string name;
+		int objectCount = -1; // -1 when unknown (legacy files)
+		int previewWidth = 0, previewHeight = 0;
+		std::vector<unsigned char> img; // RGB, previewWidth * previewHeight * 3
+		uint64_t journalSequence = 0; // last autosave journal record contained in the scene, 0 if none
+	};
+
+	// false if the file could not be written, the data is fsync'd before returning
+	static bool Write(const std::string& path, const std::string& name, Serialization serialization, uint64_t journalSequence = 0);
+	static Serialization Read(const std::string& path);
+	static MetaInfo ReadMetaInfo(const std::string& path);
+
+	static constexpr uint32_t FORMAT_VERSION = 2;
+
+private:
+	enum SectionType : uint32_t {
+		SECTION_SCENE = 1,
+		SECTION_META = 3,
+		SECTION_JOURNAL = 4, // [journalSequence:u64]
+	};
+
+	struct Section {
+		uint32_t type;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	static constexpr size_t MAGIC_SIZE = 8;
+	static constexpr size_t HEADER_SIZE = MAGIC_SIZE + 4 + 4;
+	static constexpr size_t SECTION_ENTRY_SIZE = 4 + 4 + 8 + 8;
+	static const char MAGIC[MAGIC_SIZE];
+
+	static bool HasMagic(const char* data, size_t size);
+	static bool ParseHeader(const char* data, size_t size, uint32_t& outSectionCount);
+	static bool ParseSectionTable(const char* data, uint32_t sectionCount, uint64_t fileSize, std::vector<Section>& outSections);
+	static bool ParseSections(const char* data, size_t size, std::vector<Section>& outSections);
+	static const Section* FindSection(const std::vector<Section>& sections, SectionType type);
+
+	static std::string EncodeMeta(const MetaInfo& meta);
+	static bool DecodeMeta(const char* data, size_t size, MetaInfo& outMeta);
+
+	static std::vector<char> ReadWholeFile(const std::string& path);
+	static Serialization ReadTextArchive(const char* data, size_t size, bool metaOnly);
+};
+
+
+#endif //SENIORRESEARCH_PROJECTFILE_H
@@ -49,4 +49,4 @@ std::vector<ModelObject *> Serialization::Deserialize() {
     return res;
 }
 
-bool Serialization::readMetaOnly = false;
\ No newline at end of file
+thread_local bool Serialization::readMetaOnly = false;
\ No newline at end of file
@@ -38,7 +38,7 @@ public:
     static void SetReadMetaOnly(bool _readMetaOnly) { readMetaOnly = _readMetaOnly; }
 
 private:
-    static bool readMetaOnly;
+    static thread_local bool readMetaOnly; // per thread, previews are read on pool workers
 
     friend class boost::serialization::access;
     template<class Archive>
@@ -0,0 +1,136 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "ThumbnailCache.h"
+#include "../util/ThreadPool.h"
+
+#include <fstream>
+#include <cstdlib>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/unordered_map.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace boost::serialization {
+
+	template<class Archive>
+	void serialize(Archive & ar, ProjectFile::MetaInfo& meta, const unsigned int version)
+	{
+		ar & meta.name;
+		ar & meta.objectCount;
+		ar & meta.previewWidth;
+		ar & meta.previewHeight;
+		ar & meta.img;
+	}
+
+	template<class Archive>
+	void serialize(Archive & ar, ThumbnailCache::Entry& entry, const unsigned int version)
+	{
+		ar & entry.mtime;
+		ar & entry.size;
+		ar & entry.meta;
+	}
+}
+
+std::mutex ThumbnailCache::mutex;
+std::mutex ThumbnailCache::saveMutex;
+std::unordered_map<std::string, ThumbnailCache::Entry> ThumbnailCache::entries;
+bool ThumbnailCache::loadStarted = false;
+bool ThumbnailCache::loaded = false;
+bool ThumbnailCache::dirty = false;
+
+bool ThumbnailCache::TryGet(const std::string& path, int64_t mtime, uint64_t size, ProjectFile::MetaInfo& outMeta) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	const auto it = entries.find(path);
+	if (it == entries.end() || it->second.mtime != mtime || it->second.size != size) return false;
+
+	outMeta = it->second.meta;
+	return true;
+}
+
+void ThumbnailCache::Put(const std::string& path, int64_t mtime, uint64_t size, const ProjectFile::MetaInfo& meta) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	entries[path] = {mtime, size, meta};
+	dirty = true;
+}
+
+void ThumbnailCache::SaveIfDirty() {
+	std::lock_guard<std::mutex> saveLock(saveMutex);
+
+	std::unordered_map<std::string, Entry> toWrite;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!dirty || !loaded) return; // saving before the load lands would drop the entries on disk
+		toWrite = entries;
+		dirty = false;
+	}
+
+	std::erase_if(toWrite, [](const auto& pair) {
+		std::error_code err;
+		return !std::filesystem::exists(pair.first, err);
+	});
+
+	const std::filesystem::path cachePath = CachePath();
+	std::error_code err;
+	std::filesystem::create_directories(cachePath.parent_path(), err);
+
+	std::filesystem::path tempPath = cachePath;
+	tempPath += ".tmp";
+	{
+		std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+		if (!ofs) return;
+		boost::archive::binary_oarchive oa(ofs);
+		oa << toWrite;
+	}
+
+	std::filesystem::rename(tempPath, cachePath, err);
+	if (err) LOG("[Warning]: could not write thumbnail cache: %s", err.message().c_str());
+}
+
+void ThumbnailCache::LoadAsync() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (loadStarted) return;
+		loadStarted = true;
+	}
+	ThreadPool::Shared().Submit([] { Load(); });
+}
+
+void ThumbnailCache::Load() {
+	std::unordered_map<std::string, Entry> fromDisk;
+
+	std::ifstream ifs(CachePath(), std::ios::binary);
+	if (ifs) {
+		try {
+			boost::archive::binary_iarchive ia(ifs);
+			ia >> fromDisk;
+		} catch (const std::exception& e) { // stale or corrupt cache is just rebuilt
+			LOG("[Warning]: discarding thumbnail cache: %s", e.what());
+			fromDisk.clear();
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (auto& [path, entry] : fromDisk) entries.try_emplace(path, std::move(entry)); // entries Put while loading are newer
+	loaded = true;
+}
+
+std::filesystem::path ThumbnailCache::CachePath() {
+	std::filesystem::path base;
+#ifdef __APPLE__
+	if (const char* home = std::getenv("HOME")) base = std::filesystem::path(home) / "Library" / "Caches";
+#else
+	if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) base = xdg;
+	else if (const char* home = std::getenv("HOME")) base = std::filesystem::path(home) / ".cache";
+#endif
+	if (base.empty()) {
+		std::error_code err;
+		base = std::filesystem::temp_directory_path(err);
+	}
+	return base / APP_DIRECTORY_NAME / CACHE_FILE_NAME;
+}
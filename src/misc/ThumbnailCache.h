@@ -0,0 +1,47 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_THUMBNAILCACHE_H
+#define SENIORRESEARCH_THUMBNAILCACHE_H
+
+
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <filesystem>
+#include "ProjectFile.h"
+
+// Decoded project previews keyed by path, validated against the file's mtime and size.
+// Kept in memory for the session and persisted to CACHE_FILE_NAME in the user's cache directory so a folder can be browsed without opening any .mdl.
+// Safe to call from worker threads. Until the background load started by LoadAsync finishes, lookups simply miss.
+class ThumbnailCache {
+public:
+	static void LoadAsync(); // reads the cache file on the thread pool, call once at startup
+
+	static bool TryGet(const std::string& path, int64_t mtime, uint64_t size, ProjectFile::MetaInfo& outMeta);
+	static void Put(const std::string& path, int64_t mtime, uint64_t size, const ProjectFile::MetaInfo& meta);
+
+	static void SaveIfDirty(); // writes the cache file, dropping entries whose project no longer exists
+
+	static constexpr const char* CACHE_FILE_NAME = "thumbnails.cache";
+	static constexpr const char* APP_DIRECTORY_NAME = "SeniorResearch";
+
+	struct Entry {
+		int64_t mtime = 0;
+		uint64_t size = 0;
+		ProjectFile::MetaInfo meta;
+	};
+
+private:
+	static void Load();
+	static std::filesystem::path CachePath(); // ~/Library/Caches on macOS, $XDG_CACHE_HOME or ~/.cache elsewhere
+
+	static std::mutex mutex, saveMutex;
+	static std::unordered_map<std::string, Entry> entries;
+	static bool loadStarted, loaded, dirty;
+};
+
+
+#endif //SENIORRESEARCH_THUMBNAILCACHE_H
@@ -0,0 +1,41 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "FrameScheduler.h"
+#include "../gl/Input.h"
+
+#include <glfw3.h>
+#include <thread>
+#include <chrono>
+
+void FrameScheduler::WaitForEvents(const Input& input) {
+	const bool held = input.mouseDown || input.mouseRightDown || input.mouseMiddleDown || input.AnyKeyDown(); // drags, undo repeat
+
+	bool wokeEarly = false;
+	if (animating) {
+		if (frameCap > 0) {
+			const double wait = lastFrameTime + 1.0 / frameCap - glfwGetTime();
+			if (wait > 0.0) std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+		}
+		glfwPollEvents();
+	} else if (held || settleFrames > 0) {
+		glfwPollEvents();
+	} else {
+		const double start = glfwGetTime();
+		glfwWaitEventsTimeout(IDLE_TIMEOUT);
+		// woken before the timeout by something Input has no callback for (text input, focus, empty events)
+		wokeEarly = input.eventCount == 0 && glfwGetTime() - start < IDLE_TIMEOUT * 0.9;
+	}
+
+	nonCursorEvents = input.eventCount > input.cursorEventCount || wokeEarly;
+	if (input.eventCount > 0 || wokeEarly) settleFrames = SETTLE_FRAMES;
+	else if (settleFrames > 0) settleFrames--;
+
+	animating = false;
+	lastFrameTime = glfwGetTime();
+}
+
+void FrameScheduler::Wake() {
+	glfwPostEmptyEvent();
+}
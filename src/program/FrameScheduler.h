@@ -0,0 +1,57 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_FRAMESCHEDULER_H
+#define SENIORRESEARCH_FRAMESCHEDULER_H
+
+
+#include <array>
+
+class Input;
+
+// Decides when the main loop runs and which views redraw, instead of running everything flat out:
+//  - idle (no input, nothing held, nothing animating) the loop sleeps in glfwWaitEventsTimeout, waking every
+//    IDLE_TIMEOUT so timers (journal flush, autosave) still tick
+//  - after any event it runs SETTLE_FRAMES more frames, ImGui needs a few to settle hover and layout
+//  - while something animates (timeline playback) it polls, capped at frameCap
+//  - workers that finish a result the loop picks up (thumbnails, saves) call Wake so it isn't left for the timeout
+// Views are only re-rendered once invalidated; their render targets keep the last image otherwise.
+class FrameScheduler {
+public:
+	enum View {
+		VIEW_SCENE_3D, VIEW_PLOT, VIEW_TIMELINE, VIEW_COUNT
+	};
+
+	FrameScheduler() { InvalidateAll(); }
+
+	// in place of glfwPollEvents, after Input::Update
+	void WaitForEvents(const Input& input);
+
+	void KeepAnimating() { animating = true; } // this frame needs a successor regardless of input, reset every frame
+
+	static void Wake(); // any thread -- ends an idle wait early, the next frame runs (and settles) as after an event
+
+	// anything but cursor motion arrived this frame (or an event Input doesn't see woke the loop)
+	[[nodiscard]] bool HadNonCursorEvents() const { return nonCursorEvents; }
+
+	void Invalidate(View view) { redrawFrames[view] = SETTLE_FRAMES; }
+	void InvalidateAll() { redrawFrames.fill(SETTLE_FRAMES); }
+	[[nodiscard]] bool NeedsRender(View view) const { return redrawFrames[view] > 0; }
+	void Rendered(View view) { if (redrawFrames[view] > 0) redrawFrames[view]--; }
+
+	int frameCap = 60; // while animating, 0 for uncapped
+
+	static constexpr double IDLE_TIMEOUT = 0.25;
+	static constexpr int SETTLE_FRAMES = 3;
+
+private:
+	bool animating = false, nonCursorEvents = false;
+	int settleFrames = SETTLE_FRAMES;
+	double lastFrameTime = 0.0;
+
+	std::array<int, VIEW_COUNT> redrawFrames {};
+};
+
+
+#endif //SENIORRESEARCH_FRAMESCHEDULER_H
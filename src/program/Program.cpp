@@ -6,6 +6,12 @@
 #include "../util/Controls.h"
 #include "../gui/Markdown.h"
 #include "../screens/auxiliary/SaveFileScreen.h"
+#include "../project/ProjectSaver.h"
+#include "../misc/Journal.h"
+#include "../misc/ThumbnailCache.h"
+#include "../animation/MeshCache.h"
+#include "../util/Profiler.h"
+#include "../util/TraceRecorder.h"
 
 Program* Program::instance = nullptr;
 
@@ -20,14 +26,16 @@ Program::Program() :
    })
 {
 	Program::instance = this;
+	TraceRecorder::NameThread("main");
 	Controls::Initialize(&input);
 
-	glfwSwapInterval(0); // NOTE: Removes limit from FPS!
+	glfwSwapInterval(0); // NOTE: Removes limit from FPS! (frameScheduler paces the loop instead)
 
 	ImGuiHelper::Initialize(window);
 	Markdown::LoadFonts();
 
 	BlendModes::GetManager().Init(); // TODO: rewrite blend-modes
+	ThumbnailCache::LoadAsync(); // ready by the time the open dialog is shown
 }
 
 void Program::Run() {
@@ -37,12 +45,13 @@ void Program::Run() {
         windowHeight = window.GetHeight();
 
 
+		input.Update();
+		frameScheduler.WaitForEvents(input); // sleeps while idle
+		Profiler::BeginFrame();
+
 		auto time = (float) glfwGetTime();
 		float deltaTime = time - lastTime;
 
-		input.Update();
-		glfwPollEvents();
-
 		Update(deltaTime);
 		Render();
 		Gui();
@@ -50,19 +59,28 @@ void Program::Run() {
 
 		lastTime = time;
 		window.SwapBuffers(); // Swap the screen buffers
+		Profiler::EndFrame();
 	}
 }
 
 void Program::Update(float deltaTime) {
+	PROFILE_SCOPE("Program::Update");
 	GlobalHotKeys();
 
 	window.SetTitle(selectedProject->GenWindowTitle().c_str());
 
-	guiScreens[currentGuiScreen]->Update(deltaTime);
+	{
+		PROFILE_SCOPE("GuiScreen::Update");
+		guiScreens[currentGuiScreen]->Update(deltaTime);
+	}
+
+	ProjectSaver::Update();
+	Journal::Update(*selectedProject, deltaTime);
 }
 
 void Program::PostEvents(float deltaTime) {
 	// screen-specific post events
+	PROFILE_SCOPE("GuiScreen::PostUpdate");
 	guiScreens[currentGuiScreen]->PostUpdate(deltaTime);
 
 	// Global post events
@@ -93,13 +111,16 @@ void Program::GlobalHotKeys() {
 	if (Controls::Check(CONTROLS_OpenFileOpenMenu)) OpenGuiScreen(GuiScreenType::OPEN_MENU);
 	if (Controls::Check(CONTROLS_OpenExportMenu)) OpenGuiScreen(GuiScreenType::EXPORT_MENU);
 	if (Controls::Check(CONTROLS_OpenControlsMenu)) OpenGuiScreen(GuiScreenType::CONTROLS_MENU);
+	if (Controls::Check(CONTROLS_ToggleTraceRecording)) TraceRecorder::Toggle();
 }
 
 void Program::Render() {
+	PROFILE_GPU_SCOPE("Program::Render");
 	guiScreens[currentGuiScreen]->Render();
 }
 
 void Program::Gui() {
+	PROFILE_GPU_SCOPE("Program::Gui");
 
 	ImGuiHelper::BeginFrame();
 	ImGui::DockSpaceOverViewport(ImGui::GetMainViewport());
@@ -116,12 +137,20 @@ void Program::Terminate() { // NOTE: called on destruction
 }
 
 Program::~Program() {
+	if (TraceRecorder::IsRecording()) TraceRecorder::Toggle(); // don't lose a recording left running
+	ProjectSaver::Finish();
+	Journal::Detach(); // clean shutdown, nothing to recover
+	Journal::Finish();
 	Terminate();
 }
 
 void Program::AddProjectAsActive(const std::shared_ptr<Project>& newProject) {
 	projects = {newProject};
 	selectedProject = newProject;
+	MeshCache::Clear(); // object IDs restart per project
+
+	if (newProject->IsUntitled()) Journal::Detach();
+	else Journal::Attach(newProject->GetPath(), *newProject);
 }
 
 void Program::SaveHotKey() {
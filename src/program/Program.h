@@ -22,6 +22,7 @@
 #include "../screens/auxiliary/SaveFileScreen.h"
 #include "../screens/auxiliary/ExportScreen.h"
 #include "../screens/auxiliary/ControlScreen.h"
+#include "FrameScheduler.h"
 
 
 // >> START CONSTANTS
@@ -48,7 +49,9 @@ public:
 
 	[[nodiscard]] static Program& GetInstance() { return *Program::instance; };
 	[[nodiscard]] static Input& GetInput() { return Program::instance->input; }
+	[[nodiscard]] static FrameScheduler& GetFrameScheduler() { return Program::instance->frameScheduler; }
 	[[nodiscard]] static Project& GetProject() { return *Program::instance->selectedProject; }
+	[[nodiscard]] static const std::shared_ptr<Project>& GetSelectedProject() { return Program::instance->selectedProject; }
 	[[nodiscard]] static unsigned int GetWindowWidth() { return Program::instance->windowWidth; }
 	[[nodiscard]] static unsigned int GetWindowHeight() { return Program::instance->windowHeight; }
 	[[nodiscard]] static bool JustEnteredGuiScreen() { return Program::instance->justEnteredGuiScreen; }
@@ -75,6 +78,7 @@ private:
 
 	GLWindow window {INIT_WIDTH, INIT_HEIGHT}; // GLFW window
 	Input& input;
+	FrameScheduler frameScheduler;
 
 	unsigned int windowWidth = INIT_WIDTH;
 	unsigned int windowHeight = INIT_HEIGHT;
@@ -5,12 +5,13 @@
 #include "Project.h"
 #include "../generation/Lathe.h"
 #include "../misc/Serialization.h"
+#include "../misc/ProjectFile.h"
+#include "../misc/Journal.h"
 #include "../util/ModelObjectHelper.h"
+#include "../util/ThreadPool.h"
 #include <iostream>
-#include <fstream>
 
 #include <vector>
-#include <boost/archive/text_iarchive.hpp>
 
 
 Project::Project() {
@@ -26,11 +27,8 @@ Project::Project(std::string path) {
 	name = name.substr(0, name.find_first_of('.'));
 
 	LOG("loading from \"%s\" -- ", path.c_str());
-	Serialization serialization;
-
-	std::ifstream ifs (path);
-	boost::archive::text_iarchive ia(ifs);
-	ia >> serialization;
+	const Journal::Recovery recovery = Journal::PrepareRecovery(path);
+	Serialization serialization = ProjectFile::Read(recovery.sourcePath);
 
 	auto modelObjectPtrs = serialization.Deserialize();
 
@@ -40,8 +38,15 @@ Project::Project(std::string path) {
 
 	currentModelObject = modelObjects[0];
 
-	for (const auto& modelObj : modelObjects) {
-		modelObj->UpdateMesh();
+	Journal::Replay(path, recovery.baseSequence, modelObjects); // unsaved edits from a session that didn't shut down cleanly
+
+	// geometry is generated across the pool, then uploaded in order on the main thread (GL isn't thread-safe)
+	std::vector<MeshData> meshData(modelObjects.size());
+	ThreadPool::Shared().ParallelFor(modelObjects.size(), [&](size_t i) {
+		meshData[i] = modelObjects[i]->GenMeshData();
+	});
+	for (size_t i = 0; i < modelObjects.size(); i++) {
+		modelObjects[i]->ApplyMeshData(meshData[i]);
 	}
 
 	MakeExisting(name, path);
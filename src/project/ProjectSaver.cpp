@@ -0,0 +1,145 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "ProjectSaver.h"
+#include "../misc/ProjectFile.h"
+#include "../screens/MainScreen.h"
+#include "../misc/Journal.h"
+#include "../program/Program.h"
+
+#include <unordered_map>
+#include <filesystem>
+
+std::vector<ProjectSaver::PendingSave> ProjectSaver::awaitingPreview;
+std::atomic<int> ProjectSaver::writesInFlight = 0;
+std::mutex ProjectSaver::finishedMutex;
+std::vector<ProjectSaver::FinishedWrite> ProjectSaver::finished;
+
+void ProjectSaver::Save(const std::shared_ptr<Project>& project, const std::string& path, const std::string& name) {
+	LOG("saving to \"%s\"...", path.c_str());
+
+	if (project->IsUntitled() || path != project->GetPath()) Journal::Attach(path, *project); // edits from here on belong to the new file
+
+	awaitingPreview.push_back({
+		path, name,
+		project,
+		TakeSnapshot(*project),
+		MainScreen::GetComponents().sceneView3D.BeginPreviewSnapshot(),
+		Journal::Flush(), // everything recorded so far is contained in the snapshot
+	});
+}
+
+std::shared_ptr<ProjectSaver::Snapshot> ProjectSaver::TakeSnapshot(const Project& project) {
+	const auto& modelObjects = project.GetModelObjects();
+	auto snapshot = std::make_shared<Snapshot>();
+
+	std::unordered_map<const ModelObject*, ModelObject*> originalToClone;
+	snapshot->clones.reserve(modelObjects.size());
+	for (const auto& modelObject : modelObjects) {
+		ModelObject* clone = modelObject->Clone();
+		originalToClone[modelObject.get()] = clone;
+		snapshot->clones.push_back(clone);
+	}
+	for (ModelObject* clone : snapshot->clones) clone->RemapHierarchy(originalToClone);
+
+	snapshot->serialization = Serialization(snapshot->clones, {});
+	return snapshot;
+}
+
+bool ProjectSaver::WriteAtomically(const std::string& path, const std::string& name, const Serialization& serialization, uint64_t journalSequence) {
+	const std::string tempPath = path + ".tmp";
+
+	bool written = false;
+	try {
+		written = ProjectFile::Write(tempPath, name, serialization, journalSequence);
+	} catch (const std::exception& e) {
+		LOG("[Warning]: failed to serialize \"%s\": %s", path.c_str(), e.what());
+	}
+
+	std::error_code err;
+	if (!written) {
+		std::filesystem::remove(tempPath, err);
+		return false;
+	}
+
+	std::filesystem::rename(tempPath, path, err);
+	if (err) {
+		LOG("[Warning]: failed to replace \"%s\": %s", path.c_str(), err.message().c_str());
+		return false;
+	}
+	return true;
+}
+
+void ProjectSaver::Update() {
+	ApplyFinishedWrites();
+
+	while (!awaitingPreview.empty()) {
+		PendingSave& save = awaitingPreview.front();
+
+		std::vector<unsigned char> preview;
+		if (!RenderTarget::TryFinishReadback(save.readback, 64, preview)) break; // keeps saves in request order
+
+		save.snapshot->serialization.img = std::move(preview);
+		DispatchWrite(save);
+		awaitingPreview.erase(awaitingPreview.begin());
+	}
+
+	if (!awaitingPreview.empty()) Program::GetFrameScheduler().KeepAnimating(); // readbacks are polled, nothing posts an event
+}
+
+void ProjectSaver::Finish() {
+	while (!awaitingPreview.empty()) Update();
+	Writer().Wait();
+	ApplyFinishedWrites();
+}
+
+void ProjectSaver::DispatchWrite(PendingSave& save) {
+	writesInFlight++;
+
+	Writer().Submit([path = save.path, name = save.name, project = save.project, snapshot = save.snapshot, journalSequence = save.journalSequence] {
+		const bool written = WriteAtomically(path, name, snapshot->serialization, journalSequence);
+		if (written) Journal::OnProjectWritten(path, journalSequence);
+
+		{
+			std::lock_guard<std::mutex> lock(finishedMutex);
+			finished.push_back({path, name, project, written});
+		}
+		FrameScheduler::Wake();
+	});
+}
+
+void ProjectSaver::ApplyFinishedWrites() {
+	std::vector<FinishedWrite> writes;
+	{
+		std::lock_guard<std::mutex> lock(finishedMutex);
+		writes.swap(finished);
+	}
+
+	for (const FinishedWrite& write : writes) {
+		writesInFlight--;
+		Apply(write);
+	}
+}
+
+void ProjectSaver::Apply(const FinishedWrite& write) {
+	const std::shared_ptr<Project> project = write.project.lock();
+
+	if (write.written) {
+		LOG("save successful!");
+		if (project) project->MakeExisting(write.name, write.path);
+		return;
+	}
+
+	LOG("[Error]: could not save to \"%s\", the project keeps its previous file", write.path.c_str());
+
+	// Save() already moved the journal over to the new path, move it back unless another save will settle it
+	if (!project || project.get() != &Program::GetProject() || IsSaving()) return;
+	if (project->IsUntitled()) Journal::Detach();
+	else if (project->GetPath() != write.path) Journal::Attach(project->GetPath(), *project);
+}
+
+ThreadPool& ProjectSaver::Writer() {
+	static ThreadPool writer(1); // one thread so writes to the same path land in order
+	return writer;
+}
@@ -0,0 +1,75 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_PROJECTSAVER_H
+#define SENIORRESEARCH_PROJECTSAVER_H
+
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include "Project.h"
+#include "../gl/RenderTarget.h"
+#include "../misc/Serialization.h"
+#include "../util/ThreadPool.h"
+
+// Saves without stalling the UI thread:
+//  1. Save() clones the model objects (plain value copies, no GPU state) and queues a PBO readback of the preview
+//  2. Update() collects finished readbacks each frame and hands the snapshot to a single writer thread
+//  3. the writer serializes to "<path>.tmp" and atomically renames it over the project file
+//  4. Update() takes the project to its new name and path only once its write succeeded
+// Saves complete in the order they were requested.
+class ProjectSaver {
+public:
+	// detached copy of a project's objects that worker threads may serialize while editing continues
+	struct Snapshot {
+		std::vector<ModelObject*> clones;
+		Serialization serialization;
+
+		Snapshot() = default;
+		Snapshot(const Snapshot&) = delete;
+		~Snapshot() { for (ModelObject* clone : clones) delete clone; }
+	};
+
+	static void Save(const std::shared_ptr<Project>& project, const std::string& path, const std::string& name);
+	static void Update(); // main thread, once per frame
+	static void Finish(); // blocks until every queued save is on disk (call before the GL context goes away)
+
+	[[nodiscard]] static bool IsSaving() { return !awaitingPreview.empty() || writesInFlight > 0; }
+
+	static std::shared_ptr<Snapshot> TakeSnapshot(const Project& project); // main thread
+	// any thread -- writes "<path>.tmp" and renames it over path
+	static bool WriteAtomically(const std::string& path, const std::string& name, const Serialization& serialization, uint64_t journalSequence);
+
+private:
+	struct PendingSave {
+		std::string path, name;
+		std::weak_ptr<Project> project; // the project may be closed before its save lands
+		std::shared_ptr<Snapshot> snapshot;
+		RenderTarget::PendingReadback readback;
+		uint64_t journalSequence; // last journal record contained in the snapshot
+	};
+
+	struct FinishedWrite {
+		std::string path, name;
+		std::weak_ptr<Project> project;
+		bool written;
+	};
+
+	static void DispatchWrite(PendingSave& save);
+	static void ApplyFinishedWrites(); // main thread
+	static void Apply(const FinishedWrite& write);
+	static ThreadPool& Writer();
+
+	static std::vector<PendingSave> awaitingPreview;
+	static std::atomic<int> writesInFlight; // dispatched but not yet applied
+
+	static std::mutex finishedMutex;
+	static std::vector<FinishedWrite> finished; // guarded by finishedMutex
+};
+
+
+#endif //SENIORRESEARCH_PROJECTSAVER_H
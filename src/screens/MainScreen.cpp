@@ -5,6 +5,9 @@
 #include "MainScreen.h"
 #include "../program/Program.h"
 #include "../display/ParamEditor.h"
+#include "../misc/Journal.h"
+#include "../animation/MeshCache.h"
+#include "../util/Profiler.h"
 
 MainScreen* MainScreen::instance = nullptr;
 
@@ -28,8 +31,14 @@ void MainScreen::Update(float deltaTime) {
 
 	// Updating
 	timeline.SetActiveAnimator(project.GetCurrentModelObject()->GetAnimatorPtr());
-	plot.Update(project, deltaTime);
-	sceneView3D.Update(project, deltaTime);
+	{
+		PROFILE_SCOPE("Plot::Update");
+		plot.Update(project, deltaTime);
+	}
+	{
+		PROFILE_SCOPE("SceneView3D::Update");
+		sceneView3D.Update(project, deltaTime);
+	}
 }
 
 // After GUI
@@ -39,18 +48,80 @@ void MainScreen::PostUpdate(float deltaTime) {
 
 	// POST UPDATE EVENTS
 	timeline.Update({Program::GetInput(), deltaTime, plot.GetDrawMode(), *project.GetCurrentModelObject(), project.GetModelObjects(), sceneHierarchy.FocusModeActive()});
+	JournalDiffs(*project.GetCurrentModelObject());
 	project.GetCurrentModelObject()->UnDiffAll();
 	plot.PostUpdate(project, deltaTime);
 	sceneView3D.PostUpdate(project, deltaTime);
+
+	// edits remesh on the thread pool, finished meshes are swapped in here -- until then the last one stays on screen
+	bool meshPending = false;
+	for (const auto& obj : project.GetModelObjects()) {
+		obj->SwapMesh();
+		meshPending |= obj->IsMeshPending();
+	}
+
+	if (timeline.IsPlaying() || meshPending) Program::GetFrameScheduler().KeepAnimating();
 }
 
 void MainScreen::Render() {
 
 	Project& project = Program::GetProject();
+	FrameScheduler& frameScheduler = Program::GetFrameScheduler();
+
+	InvalidateViews(project);
+
+	if (frameScheduler.NeedsRender(FrameScheduler::VIEW_SCENE_3D)) {
+		PROFILE_GPU_SCOPE("SceneView3D::Render");
+		sceneView3D.Render(project);
+		frameScheduler.Rendered(FrameScheduler::VIEW_SCENE_3D);
+	}
+	if (frameScheduler.NeedsRender(FrameScheduler::VIEW_PLOT)) {
+		PROFILE_GPU_SCOPE("Plot::Render");
+		plot.Render(project);
+		frameScheduler.Rendered(FrameScheduler::VIEW_PLOT);
+	}
+	if (frameScheduler.NeedsRender(FrameScheduler::VIEW_TIMELINE)) {
+		PROFILE_GPU_SCOPE("Timeline::Render");
+		timeline.Render({plot.GetDrawMode(), Program::GetInput()});
+		frameScheduler.Rendered(FrameScheduler::VIEW_TIMELINE);
+	}
+}
 
-	sceneView3D.Render(project);
-	plot.Render(project);
-	timeline.Render({plot.GetDrawMode(), Program::GetInput()});
+// every view draws the whole project, so any change to it (edits, keyframes, playhead, selection, visibility) redraws
+// all of them. Input only redraws what it can affect: clicks, keys and drags everything, cursor motion the views under
+// the cursor (hover gizmos).
+void MainScreen::InvalidateViews(const Project& project) {
+	FrameScheduler& frameScheduler = Program::GetFrameScheduler();
+	const Input& input = Program::GetInput();
+
+	size_t signature = std::hash<const void*>()(project.GetCurrentModelObject().get());
+	const auto Combine = [&](size_t value) { signature ^= value + 0x9e3779b97f4a7c15ull + (signature << 6) + (signature >> 2); };
+	Combine(std::hash<int>()(plot.GetDrawMode()));
+	Combine(std::hash<bool>()(sceneHierarchy.FocusModeActive()));
+	Combine(std::hash<float>()(project.GetCurrentModelObject()->GetAnimatorPtr()->GetTime()));
+	for (const auto& obj : project.GetModelObjects()) {
+		Combine(std::hash<int>()(obj->GetID()));
+		Combine(std::hash<uint64_t>()(obj->GetEditGeneration()));
+		Combine(std::hash<uint64_t>()(obj->GetMeshGeneration())); // edits land a few frames later, see PostUpdate
+		Combine(std::hash<uint64_t>()(obj->GetAnimatorPtr()->GetRevision()));
+		Combine(std::hash<bool>()(obj->IsVisible()));
+	}
+
+	const bool held = input.mouseDown || input.mouseRightDown || input.mouseMiddleDown;
+	if (signature != lastViewSignature || held || frameScheduler.HadNonCursorEvents()) {
+		frameScheduler.InvalidateAll();
+		lastViewSignature = signature;
+		return;
+	}
+
+	if (input.cursorEventCount == 0) return;
+	const auto Hovered = [&](const Rectangle& rect) {
+		return Util::VecIsNormalizedNP(Util::NormalizeToRectNP(input.GetMouse(), rect))
+		    || Util::VecIsNormalizedNP(Util::NormalizeToRectNP(input.GetLastMouse(), rect)); // leaving clears hover gizmos
+	};
+	if (Hovered(sceneView3D.GetDisplayRect())) frameScheduler.Invalidate(FrameScheduler::VIEW_SCENE_3D);
+	if (Hovered(plot.GetPlotRect())) frameScheduler.Invalidate(FrameScheduler::VIEW_PLOT);
+	if (Hovered(timeline.GetGuiRect())) frameScheduler.Invalidate(FrameScheduler::VIEW_TIMELINE);
 }
 
 void MainScreen::Gui() {
@@ -64,6 +135,17 @@ void MainScreen::Gui() {
 	sceneHierarchy.Gui(project);
 	plot.ToolbarGui(project);
 	ParamEditor::Gui();
+
+	if (DEVELOPER_MODE) {
+		MeshCache::DebugGui();
+		Profiler::Gui();
+	}
+}
+
+void MainScreen::JournalDiffs(ModelObject& modelObject) {
+	for (const auto mode : {Enums::MODE_PLOT, Enums::MODE_GRAPH_Y, Enums::MODE_GRAPH_Z, Enums::MODE_CROSS_SECTION}) {
+		if (modelObject.HasDiff(mode)) Journal::RecordPolyline(modelObject.GetID(), mode, modelObject.GetPointsRefByMode(mode));
+	}
 }
 
 void MainScreen::HotKeys() {
@@ -32,6 +32,8 @@ public:
 
 private:
 	void HotKeys();
+	static void JournalDiffs(ModelObject& modelObject); // this frame's polyline edits
+	void InvalidateViews(const Project& project); // marks the views FrameScheduler should redraw this frame
 
 	static MainScreen* instance;
 
@@ -43,6 +45,8 @@ private:
 	SceneHierarchy sceneHierarchy = {};
 
 	MainScreenComponents components;
+
+	size_t lastViewSignature = 0;
 };
 
 
@@ -4,12 +4,14 @@
 
 #include "OpenFileScreen.h"
 #include "../../program/Program.h"
+#include "../../misc/ProjectFile.h"
+#include "../../misc/ThumbnailCache.h"
+#include "../../util/ThreadPool.h"
+#include "../../program/FrameScheduler.h"
 
 #include <iostream>
-#include <fstream>
 
 #include <vector>
-#include <boost/archive/text_iarchive.hpp>
 
 void OpenFileScreen::Gui() {
 
@@ -37,24 +39,11 @@ void OpenFileScreen::Gui() {
 				if (p.path().extension() == ".mdl") paths.emplace_back(p.path());
 			}
 		}
-		std::vector<Serialization> metaReads;
-		metaReads.reserve(paths.size());
-		for (const std::string& pathStr : paths) {
-			auto& ref = metaReads.emplace_back(DeserializeMetaInfo(pathStr));
-			const int desiredSize = 64 * 64 * 3;
-			if (ref.img.size() != desiredSize) {
-				LOG("[Warning]: Preview image is incorrect size!");
-				ref.img.clear();
-				ref.img.reserve(desiredSize);
-				for (int i = 0; i < desiredSize; i++) {ref.img.emplace_back(0);}
-			}
-		}
-
-		openFileTextureAtlas.Generate(64, Linq::Select<Serialization, std::vector<unsigned char>*>(metaReads, [](Serialization& refVal){
-			return &(refVal.img);
-		}));
+		RequestThumbnails();
 	}
 
+	ReceiveThumbnails();
+
 	bool reloadFolder = false;
 	if (!pathExists) {
 		ImGui::Text("Invalid path!");
@@ -93,9 +82,7 @@ void OpenFileScreen::Gui() {
 
 				ImGui::EndPopup();
 			}
-			childPathIndex++;
-			{ // displays a shortened version of the filename
-				// TODO: once filename vs. extension is serialized properly, this should be removed
+			{ // displays a shortened version of the filename (the name stored in the file goes stale once it's renamed on disk)
 				std::string fileName = childPath.filename();
 
 				const auto index = (int) fileName.find_last_of('.');
@@ -115,6 +102,7 @@ void OpenFileScreen::Gui() {
 				ImGui::Text("%s", fileName.c_str());
 				if (shortened && ImGui::IsItemHovered()) ImGui::SetTooltip("%s", fullFileName.c_str());
 			}
+			childPathIndex++;
 			ImGui::NextColumn();
 		}
 
@@ -131,17 +119,73 @@ void OpenFileScreen::Gui() {
 	ImGui::End();
 }
 
-Serialization OpenFileScreen::DeserializeMetaInfo(const std::string &path) {
+ProjectFile::MetaInfo OpenFileScreen::DeserializeMetaInfo(const std::string &path) {
+	return ProjectFile::ReadMetaInfo(path);
+}
+
+void OpenFileScreen::RequestThumbnails() {
+	thumbnailGeneration++;
+	pendingThumbnails = 0;
+
+	openFileTextureAtlas.Allocate(64, (int) paths.size());
+
+	for (int i = 0; i < (int) paths.size(); i++) {
+		std::error_code timeErr, sizeErr;
+		const int64_t mtime = std::filesystem::last_write_time(paths[i], timeErr).time_since_epoch().count();
+		const uint64_t size = std::filesystem::file_size(paths[i], sizeErr);
+		const bool cacheable = !timeErr && !sizeErr;
+
+		ProjectFile::MetaInfo cached;
+		if (cacheable && ThumbnailCache::TryGet(paths[i].string(), mtime, size, cached)) {
+			ApplyThumbnail(i, cached);
+			continue;
+		}
+
+		pendingThumbnails++;
+		ThreadPool::Shared().Submit([inbox = thumbnailInbox, generation = thumbnailGeneration, index = i, pathStr = paths[i].string(), mtime, size, cacheable] {
+			ProjectFile::MetaInfo meta;
+			try {
+				meta = DeserializeMetaInfo(pathStr);
+				if (cacheable) ThumbnailCache::Put(pathStr, mtime, size, meta);
+			} catch (const std::exception& e) {
+				LOG("[Warning]: could not read preview of \"%s\": %s", pathStr.c_str(), e.what());
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(inbox->mutex);
+				inbox->loaded.push_back({generation, index, std::move(meta)});
+			}
+			FrameScheduler::Wake(); // shown tile by tile, not every IDLE_TIMEOUT
+		});
+	}
+}
+
+void OpenFileScreen::ReceiveThumbnails() {
+	std::vector<LoadedThumbnail> loaded;
+	{
+		std::lock_guard<std::mutex> lock(thumbnailInbox->mutex);
+		loaded.swap(thumbnailInbox->loaded);
+	}
 
-	Serialization::SetReadMetaOnly(true);
-	Serialization serialization;
+	for (const LoadedThumbnail& thumbnail : loaded) {
+		if (thumbnail.generation != thumbnailGeneration) continue;
 
-	std::ifstream ifs(path);
-	boost::archive::text_iarchive ia(ifs);
-	ia >> serialization;
-	Serialization::SetReadMetaOnly(false);
+		ApplyThumbnail(thumbnail.index, thumbnail.meta);
 
-	return serialization;
+		if (--pendingThumbnails == 0) {
+			ThreadPool::Shared().Submit([] { ThumbnailCache::SaveIfDirty(); });
+		}
+	}
+}
+
+void OpenFileScreen::ApplyThumbnail(int index, const ProjectFile::MetaInfo& meta) {
+	if (index >= (int) paths.size()) return;
+
+	if (meta.img.size() != 64 * 64 * 3) {
+		LOG("[Warning]: Preview image is incorrect size!");
+		return; // placeholder stays
+	}
+	openFileTextureAtlas.SetTile(index, meta.img);
 }
 
 void OpenFileScreen::AddProjectFromDeserialized(const std::string &path) {
@@ -7,10 +7,12 @@
 
 
 #include "../GuiScreen.h"
-#include "../../misc/Serialization.h"
+#include "../../misc/ProjectFile.h"
 #include "../../gl/TiledTextureAtlas.h"
 #include <string>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 
 class OpenFileScreen : public GuiScreen {
 public:
@@ -18,7 +20,21 @@ public:
 
 private:
 	static void AddProjectFromDeserialized(const std::string& path);
-	static Serialization DeserializeMetaInfo(const std::string& path);
+	static ProjectFile::MetaInfo DeserializeMetaInfo(const std::string& path);
+
+	struct LoadedThumbnail {
+		int generation, index;
+		ProjectFile::MetaInfo meta;
+	};
+
+	struct ThumbnailInbox { // filled by pool workers, drained on the main thread
+		std::mutex mutex;
+		std::vector<LoadedThumbnail> loaded;
+	};
+
+	void RequestThumbnails();
+	void ReceiveThumbnails();
+	void ApplyThumbnail(int index, const ProjectFile::MetaInfo& meta);
 
 	TiledTextureAtlas openFileTextureAtlas;
 
@@ -26,6 +42,10 @@ private:
 	std::string lastPath;
 	std::vector<std::string> subFolders;
 	std::vector<std::filesystem::path> paths;
+
+	std::shared_ptr<ThumbnailInbox> thumbnailInbox = std::make_shared<ThumbnailInbox>();
+	int thumbnailGeneration = 0; // bumped per folder listing so late results from an old listing are dropped
+	int pendingThumbnails = 0;
 };
 
 
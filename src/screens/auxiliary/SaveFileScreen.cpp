@@ -4,11 +4,11 @@
 
 #include "SaveFileScreen.h"
 #include "../../program/Program.h"
+#include "../../project/ProjectSaver.h"
 
 #include <iostream>
 
 #include <vector>
-#include <boost/archive/text_oarchive.hpp>
 
 void SaveFileScreen::Gui() {
 
@@ -64,19 +64,7 @@ void SaveFileScreen::TrySave() {
 }
 
 void SaveFileScreen::SerializeScene(const std::string& path, const std::string& name) {
-
-	Project& project = Program::GetProject();
-
-	LOG("saving to \"%s\"...", path.c_str());
-	std::ofstream ofs(path);
-	boost::archive::text_oarchive oa(ofs);
-	oa << Serialization(
-			Linq::Select<std::shared_ptr<ModelObject>, ModelObject*>(project.GetModelObjects(), [](auto objSharedPtr){ return objSharedPtr.get(); }),
-			MainScreen::GetComponents().sceneView3D.GenPreviewSnapshot());
-
-	project.MakeExisting(name, path);
-
-	LOG("save successful!");
+	ProjectSaver::Save(Program::GetSelectedProject(), path, name); // finishes in the background
 }
 
 void SaveFileScreen::ReSerializeProject(Project& project) {
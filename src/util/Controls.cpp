@@ -50,6 +50,7 @@ std::unordered_map<int, KeyControl> Controls::GenDefaultControls() {
             {CONTROLS_RedoHold, {"Redo Hold", GLFW_KEY_Z, {SHIFT, COMMAND}, false}},
             {CONTROLS_Copy, {"Copy", GLFW_KEY_C, {COMMAND}}},
             {CONTROLS_Paste, {"Paste", GLFW_KEY_V, {COMMAND}}},
+            {CONTROLS_ToggleTraceRecording, {"Toggle Trace Recording", GLFW_KEY_T, {COMMAND, SHIFT}}},
     };
 }
 
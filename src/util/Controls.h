@@ -48,6 +48,7 @@ static const int
     CONTROLS_SaveAs = 31,
     CONTROLS_Copy = 32,
     CONTROLS_Paste = 33,
+    CONTROLS_ToggleTraceRecording = 34,
 	CONTROLS_ = 0,
     CONTROLS_FIN = -2
 ;
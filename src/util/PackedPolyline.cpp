@@ -0,0 +1,81 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "PackedPolyline.h"
+
+#include <cmath>
+#include <algorithm>
+
+void PackedPolyline::Encode(const Vec2List& points) {
+	bytes.clear();
+	contentID = 0;
+	if (points.empty()) return;
+
+	bytes.reserve(points.size() * 3 + 8);
+	AppendVarint(bytes, points.size());
+
+	int64_t prevX = 0, prevY = 0;
+	for (const Vec2& point : points) {
+		const int64_t x = Quantize(point.x), y = Quantize(point.y);
+		AppendVarint(bytes, ZigZag(x - prevX));
+		AppendVarint(bytes, ZigZag(y - prevY));
+		prevX = x;
+		prevY = y;
+	}
+	bytes.shrink_to_fit();
+	AssignContentID();
+}
+
+void PackedPolyline::DecodeInto(Vec2List& outPoints) const {
+	outPoints.clear();
+	if (bytes.empty()) return;
+
+	const uint8_t* data = bytes.data();
+	const uint8_t* end = data + bytes.size();
+	const size_t count = ReadVarint(data, end);
+	outPoints.reserve(std::min(count, (size_t) (end - data) / 2)); // count comes from a file, a point takes 2+ bytes
+
+	int64_t x = 0, y = 0;
+	for (size_t i = 0; i < count && data < end; i++) {
+		x += UnZigZag(ReadVarint(data, end));
+		y += UnZigZag(ReadVarint(data, end));
+		outPoints.emplace_back((float) x / STEPS_PER_UNIT, (float) y / STEPS_PER_UNIT);
+	}
+}
+
+Vec2List PackedPolyline::Decode() const {
+	Vec2List points;
+	DecodeInto(points);
+	return points;
+}
+
+size_t PackedPolyline::Size() const {
+	if (bytes.empty()) return 0;
+	const uint8_t* data = bytes.data();
+	return ReadVarint(data, data + bytes.size());
+}
+
+void PackedPolyline::AppendVarint(std::vector<uint8_t>& out, uint64_t value) {
+	while (value >= 0x80) {
+		out.push_back((uint8_t) (value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((uint8_t) value);
+}
+
+uint64_t PackedPolyline::ReadVarint(const uint8_t*& data, const uint8_t* end) {
+	uint64_t value = 0;
+	for (int shift = 0; data < end && shift < 64; shift += 7) {
+		const uint8_t byte = *data++;
+		value |= (uint64_t) (byte & 0x7F) << shift;
+		if (!(byte & 0x80)) break;
+	}
+	return value;
+}
+
+int64_t PackedPolyline::Quantize(float coord) {
+	if (!std::isfinite(coord)) return 0;
+	constexpr double LIMIT = (double) (1ll << 40); // keeps deltas well inside int64
+	return (int64_t) std::llround(std::clamp((double) coord * STEPS_PER_UNIT, -LIMIT, LIMIT));
+}
@@ -0,0 +1,65 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_PACKEDPOLYLINE_H
+#define SENIORRESEARCH_PACKEDPOLYLINE_H
+
+
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/level.hpp>
+#include "Util.h"
+
+// Compact polyline storage for keyframed strokes:
+//   [pointCount:varint][x0:zigzag varint][y0:zigzag varint] then (count - 1) x [dx:zigzag varint][dy:zigzag varint]
+// Coordinates are quantized to 1 / STEPS_PER_UNIT of a plot unit, and deltas are taken between quantized
+// integers so decoding accumulates exactly (no drift along long strokes). Hand-drawn strokes pack to
+// roughly 2-3 bytes per point instead of 8.
+// The encoding is lossy by at most half a step per coordinate, so it's only used where a stroke becomes a keyframe.
+// Live strokes and undo snapshots stay exact. Project files store keyframes in this form, i.e. at the precision
+// they're held at in memory, so saving and loading round-trips them exactly.
+class PackedPolyline {
+public:
+	PackedPolyline() = default;
+	PackedPolyline(const Vec2List& points) { Encode(points); } // NOLINT -- implicit so keyframes can be built straight from live strokes
+
+	void Encode(const Vec2List& points);
+	void DecodeInto(Vec2List& outPoints) const; // reuses outPoints' capacity
+	[[nodiscard]] Vec2List Decode() const;
+
+	[[nodiscard]] size_t Size() const; // point count, read from the header without decoding
+	[[nodiscard]] bool Empty() const { return bytes.empty(); }
+	[[nodiscard]] size_t ByteSize() const { return bytes.size(); }
+	// new for every Encode or load, kept by copies: equal IDs mean equal points (0 is the empty polyline)
+	[[nodiscard]] uint64_t GetContentID() const { return contentID; }
+
+	static constexpr float STEPS_PER_UNIT = 4096.0f;
+
+private:
+	std::vector<uint8_t> bytes; // empty for an empty polyline
+	uint64_t contentID = 0;
+
+	static inline std::atomic<uint64_t> nextContentID = 1;
+	void AssignContentID() { contentID = bytes.empty() ? 0 : nextContentID++; }
+
+	static void AppendVarint(std::vector<uint8_t>& out, uint64_t value);
+	static uint64_t ReadVarint(const uint8_t*& data, const uint8_t* end);
+	static uint64_t ZigZag(int64_t value) { return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63); }
+	static int64_t UnZigZag(uint64_t value) { return (int64_t) (value >> 1) ^ -(int64_t) (value & 1); }
+	static int64_t Quantize(float coord);
+
+	friend class boost::serialization::access;
+	template<class Archive>
+	void serialize(Archive & ar, const unsigned int version)
+	{
+		ar & bytes;
+		if constexpr (Archive::is_loading::value) AssignContentID();
+	}
+};
+
+BOOST_CLASS_IMPLEMENTATION(PackedPolyline, boost::serialization::object_serializable) // no per-class header in archives
+
+#endif //SENIORRESEARCH_PACKEDPOLYLINE_H
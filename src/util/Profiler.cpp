@@ -0,0 +1,173 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "Profiler.h"
+#include "../vendor/imgui/imgui.h"
+
+#include <cstring>
+#include <thread>
+#include <algorithm>
+
+std::deque<Profiler::Frame> Profiler::frames;
+Profiler::Frame Profiler::current = {};
+bool Profiler::inFrame = false;
+std::chrono::steady_clock::time_point Profiler::frameStart;
+std::deque<Profiler::PendingQuery> Profiler::pendingQueries;
+std::vector<GLuint> Profiler::freeQueries;
+
+namespace {
+	const std::thread::id mainThread = std::this_thread::get_id(); // statics are initialized on the main thread
+
+	double MillisecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+}
+
+Profiler::Scope::Scope(const char* name, bool gpu) :
+	trace(name), name(name), active(inFrame && std::this_thread::get_id() == mainThread), start(std::chrono::steady_clock::now()) {
+	if (active && gpu) {
+		gpuBegin = AcquireQuery();
+		glQueryCounter(gpuBegin, GL_TIMESTAMP);
+	}
+}
+
+Profiler::Scope::~Scope() {
+	if (!active) return;
+
+	PhaseSample& phase = PhaseInCurrentFrame(name);
+	phase.cpuMs += MillisecondsBetween(start, std::chrono::steady_clock::now());
+	phase.calls++;
+
+	if (gpuBegin != 0) {
+		const GLuint gpuEnd = AcquireQuery();
+		glQueryCounter(gpuEnd, GL_TIMESTAMP);
+		pendingQueries.push_back({current.index, name, gpuBegin, gpuEnd});
+	}
+}
+
+void Profiler::BeginFrame() {
+	ResolveQueries();
+
+	current.index++;
+	current.cpuMs = 0.0;
+	current.phases.clear();
+	inFrame = true;
+	frameStart = std::chrono::steady_clock::now();
+}
+
+void Profiler::EndFrame() {
+	if (!inFrame) return;
+	inFrame = false;
+
+	current.cpuMs = MillisecondsBetween(frameStart, std::chrono::steady_clock::now());
+	frames.push_back(current);
+	if (frames.size() > HISTORY) frames.pop_front();
+}
+
+Profiler::PhaseSample& Profiler::PhaseInCurrentFrame(const char* name) {
+	for (auto& phase : current.phases) {
+		if (phase.name == name || std::strcmp(phase.name, name) == 0) return phase;
+	}
+	current.phases.push_back({name, 0.0, -1.0, 0});
+	return current.phases.back();
+}
+
+void Profiler::ResolveQueries() {
+	while (!pendingQueries.empty()) {
+		const PendingQuery& query = pendingQueries.front();
+
+		GLint available = 0;
+		glGetQueryObjectiv(query.end, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) return; // later queries were issued later, can't be ready either
+
+		GLuint64 begin, end;
+		glGetQueryObjectui64v(query.begin, GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(query.end, GL_QUERY_RESULT, &end);
+
+		// the frame may already have left the history
+		const auto frame = std::find_if(frames.begin(), frames.end(), [&](const Frame& f) { return f.index == query.frameIndex; });
+		if (frame != frames.end()) {
+			for (auto& phase : frame->phases) {
+				if (phase.name != query.name && std::strcmp(phase.name, query.name) != 0) continue;
+				phase.gpuMs = std::max(phase.gpuMs, 0.0) + (double) (end - begin) / 1.0e6;
+				break;
+			}
+		}
+
+		freeQueries.push_back(query.begin);
+		freeQueries.push_back(query.end);
+		pendingQueries.pop_front();
+	}
+}
+
+GLuint Profiler::AcquireQuery() {
+	if (freeQueries.empty()) {
+		GLuint query;
+		glGenQueries(1, &query);
+		return query;
+	}
+	const GLuint query = freeQueries.back();
+	freeQueries.pop_back();
+	return query;
+}
+
+void Profiler::Gui() {
+	ImGui::Begin("Profiler");
+
+	if (frames.empty()) {
+		ImGui::Text("no frames yet");
+		ImGui::End();
+		return;
+	}
+
+	double totalMs = 0.0;
+	float maxMs = 0.0f;
+	for (const auto& frame : frames) {
+		totalMs += frame.cpuMs;
+		maxMs = std::max(maxMs, (float) frame.cpuMs);
+	}
+	const double averageMs = totalMs / (double) frames.size();
+	ImGui::Text("frame: %.2f ms avg, %.2f ms max (last %zu frames)", averageMs, maxMs, frames.size());
+
+	ImGui::PlotLines("##frame-graph", [](void* data, int i) { return (float) (*(std::deque<Frame>*) data)[i].cpuMs; },
+	                 &frames, (int) frames.size(), 0, nullptr, 0.0f, std::max(maxMs, 1.0f), {ImGui::GetContentRegionAvail().x, 60.0f});
+
+	// phases of the latest frame, averaged over the history (frames the phase didn't run in count as 0)
+	if (ImGui::BeginTable("##phases", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+		ImGui::TableSetupColumn("phase");
+		ImGui::TableSetupColumn("calls");
+		ImGui::TableSetupColumn("cpu (ms)");
+		ImGui::TableSetupColumn("cpu avg");
+		ImGui::TableSetupColumn("gpu avg");
+		ImGui::TableHeadersRow();
+
+		for (const auto& phase : frames.back().phases) {
+			double cpuTotal = 0.0, gpuTotal = 0.0;
+			int gpuFrames = 0;
+			for (const auto& frame : frames) {
+				for (const auto& other : frame.phases) {
+					if (other.name != phase.name && std::strcmp(other.name, phase.name) != 0) continue;
+					cpuTotal += other.cpuMs;
+					if (other.gpuMs >= 0.0) {
+						gpuTotal += other.gpuMs;
+						gpuFrames++;
+					}
+					break;
+				}
+			}
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(phase.name);
+			ImGui::TableNextColumn(); ImGui::Text("%i", phase.calls);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", phase.cpuMs);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", cpuTotal / (double) frames.size());
+			ImGui::TableNextColumn();
+			if (gpuFrames > 0) ImGui::Text("%.3f", gpuTotal / (double) gpuFrames);
+			else ImGui::TextUnformatted("-");
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::End();
+}
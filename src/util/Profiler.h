@@ -0,0 +1,82 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_PROFILER_H
+#define SENIORRESEARCH_PROFILER_H
+
+
+#include <glad.h>
+#include <chrono>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include "TraceRecorder.h"
+
+// Per-frame timings of named phases (PROFILE_SCOPE / PROFILE_GPU_SCOPE), kept for the last HISTORY frames.
+// CPU times come from a steady clock. GPU times from GL_TIMESTAMP queries around the scope (timestamps rather than
+// GL_TIME_ELAPSED, which can't nest), read back once available, so they fill in a few frames after the CPU times.
+// Only main thread scopes are recorded, scopes on other threads are no-ops. Every scope is also a TRACE_SCOPE.
+class Profiler {
+public:
+	struct PhaseSample {
+		const char* name;
+		double cpuMs;
+		double gpuMs; // negative until resolved, or if the phase has no GPU scope
+		int calls;
+	};
+	struct Frame {
+		uint64_t index;
+		double cpuMs;
+		std::vector<PhaseSample> phases; // in the order they first finished (nested scopes before their parent)
+	};
+
+	class Scope {
+	public:
+		explicit Scope(const char* name, bool gpu = false);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		TraceRecorder::Scope trace;
+		const char* name;
+		bool active;
+		std::chrono::steady_clock::time_point start;
+		GLuint gpuBegin = 0;
+	};
+
+	static void BeginFrame(); // main loop, after waiting for events so idle time isn't counted
+	static void EndFrame();
+
+	[[nodiscard]] static const std::deque<Frame>& GetFrames() { return frames; } // oldest first, for the benchmarks
+	static void Gui();
+
+	static constexpr int HISTORY = 240;
+
+private:
+	struct PendingQuery {
+		uint64_t frameIndex;
+		const char* name;
+		GLuint begin, end;
+	};
+
+	static PhaseSample& PhaseInCurrentFrame(const char* name);
+	static void ResolveQueries();
+	static GLuint AcquireQuery();
+
+	static std::deque<Frame> frames;
+	static Frame current;
+	static bool inFrame;
+	static std::chrono::steady_clock::time_point frameStart;
+
+	static std::deque<PendingQuery> pendingQueries; // issue order
+	static std::vector<GLuint> freeQueries;
+};
+
+#define PROFILE_SCOPE(name) Profiler::Scope TRACE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) Profiler::Scope TRACE_CONCAT(profileScope, __LINE__)(name, true)
+
+
+#endif //SENIORRESEARCH_PROFILER_H
@@ -0,0 +1,96 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "ThreadPool.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+	threadCount = std::max(1u, threadCount);
+	workers.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; i++) {
+		workers.emplace_back([this, i] {
+			TraceRecorder::NameThread("pool worker " + std::to_string(i));
+			WorkerLoop();
+		});
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	taskAvailable.notify_all();
+
+	for (std::thread& worker : workers) worker.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	taskAvailable.notify_one();
+}
+
+void ThreadPool::Wait() {
+	std::unique_lock<std::mutex> lock(mutex);
+	idle.wait(lock, [this] { return tasks.empty() && running == 0; });
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& func) {
+	if (count == 0) return;
+
+	struct Progress {
+		std::atomic<size_t> next = 0, done = 0;
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+	auto progress = std::make_shared<Progress>(); // helpers may only get scheduled after we've returned
+
+	// func is only dereferenced for a claimed index, and we can't return before every claimed index is done
+	const auto Drain = [progress, count, &func] {
+		for (size_t i = progress->next++; i < count; i = progress->next++) {
+			func(i);
+			if (++progress->done == count) {
+				std::lock_guard<std::mutex> lock(progress->mutex);
+				progress->finished.notify_all();
+			}
+		}
+	};
+
+	const size_t helperCount = std::min(workers.size(), count - 1);
+	for (size_t i = 0; i < helperCount; i++) Submit(Drain);
+	Drain();
+
+	std::unique_lock<std::mutex> lock(progress->mutex);
+	progress->finished.wait(lock, [&] { return progress->done == count; });
+}
+
+void ThreadPool::WorkerLoop() {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			taskAvailable.wait(lock, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty()) return; // only reached once stopping
+
+			task = std::move(tasks.front());
+			tasks.pop_front();
+			running++;
+		}
+		task();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--running == 0 && tasks.empty()) idle.notify_all();
+	}
+}
+
+ThreadPool& ThreadPool::Shared() {
+	static ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+	return pool;
+}
@@ -0,0 +1,48 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_THREADPOOL_H
+#define SENIORRESEARCH_THREADPOOL_H
+
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Fixed set of worker threads pulling tasks off a shared FIFO queue.
+// Tasks must not touch GL -- results that need uploading are handed back to the main thread by the caller.
+class ThreadPool {
+public:
+	explicit ThreadPool(unsigned int threadCount);
+	~ThreadPool(); // finishes all queued tasks before joining
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void Submit(std::function<void()> task);
+	void Wait(); // blocks until the queue is empty and no task is running, tasks may keep submitting meanwhile
+
+	// runs func(0 .. count - 1) on the workers and the calling thread, returns once every index is done
+	void ParallelFor(size_t count, const std::function<void(size_t)>& func);
+
+	[[nodiscard]] unsigned int GetThreadCount() const { return (unsigned int) workers.size(); }
+
+	static ThreadPool& Shared(); // lazily created, one thread per core minus the main thread
+
+private:
+	void WorkerLoop();
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable taskAvailable, idle;
+	unsigned int running = 0; // tasks taken off the queue but not yet finished
+	bool stopping = false;
+};
+
+
+#endif //SENIORRESEARCH_THREADPOOL_H
@@ -0,0 +1,147 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#include "TraceRecorder.h"
+#include "Util.h"
+
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+
+std::atomic<bool> TraceRecorder::recording = false;
+std::atomic<uint32_t> TraceRecorder::session = 0;
+std::atomic<uint64_t> TraceRecorder::sessionStartNs = 0;
+std::mutex TraceRecorder::registryMutex;
+std::vector<std::unique_ptr<TraceRecorder::ThreadBuffer>> TraceRecorder::buffers;
+
+void TraceRecorder::Start() {
+	if (IsRecording()) return;
+
+	sessionStartNs = Now();
+	session++;
+	recording = true;
+}
+
+std::string TraceRecorder::Stop() {
+	if (!IsRecording()) return "";
+	recording = false;
+
+	char stamp[32];
+	const std::time_t now = std::time(nullptr);
+	std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+
+	std::error_code err;
+	std::filesystem::create_directories(TRACE_DIRECTORY, err);
+	const std::string path = std::string(TRACE_DIRECTORY) + "/trace_" + stamp + ".json";
+
+	// scopes still open on other threads may land after this, they're left out
+	return Write(path, session, sessionStartNs) ? path : "";
+}
+
+void TraceRecorder::Toggle() {
+	if (!IsRecording()) {
+		Start();
+		LOG("[Trace]: recording");
+		return;
+	}
+
+	const std::string path = Stop();
+	if (path.empty()) LOG("[Error]: could not write trace");
+	else LOG("[Trace]: written to %s", path.c_str());
+}
+
+void TraceRecorder::NameThread(std::string name) {
+	ThreadBuffer& buffer = LocalBuffer();
+	std::lock_guard lock(registryMutex);
+	buffer.name = std::move(name);
+}
+
+uint64_t TraceRecorder::Now() {
+	return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TraceRecorder::Push(const char* name, uint64_t startNs, uint64_t endNs) {
+	ThreadBuffer& buffer = LocalBuffer();
+
+	const uint32_t current = session.load(std::memory_order_acquire);
+	if (buffer.session.load(std::memory_order_relaxed) != current) { // first event of this recording
+		buffer.count.store(0, std::memory_order_relaxed);
+		buffer.dropped.store(0, std::memory_order_relaxed);
+		buffer.session.store(current, std::memory_order_release);
+	}
+	if (!buffer.events) buffer.events = std::make_unique<Event[]>(EVENTS_PER_THREAD);
+
+	const size_t i = buffer.count.load(std::memory_order_relaxed);
+	if (i >= EVENTS_PER_THREAD) {
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	buffer.events[i] = {name, startNs, endNs};
+	buffer.count.store(i + 1, std::memory_order_release);
+}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::LocalBuffer() {
+	thread_local ThreadBuffer* local = nullptr;
+	if (!local) {
+		std::lock_guard lock(registryMutex);
+		auto buffer = std::make_unique<ThreadBuffer>();
+		buffer->tid = (int) buffers.size() + 1;
+		buffer->name = "thread " + std::to_string(buffer->tid);
+		local = buffer.get();
+		buffers.push_back(std::move(buffer));
+	}
+	return *local;
+}
+
+bool TraceRecorder::Write(const std::string& path, uint32_t recordedSession, uint64_t startNs) {
+	std::ofstream out(path);
+	if (!out) return false;
+
+	const auto Escaped = [](const std::string& str) {
+		std::string escaped;
+		for (char c : str) {
+			if (c == '"' || c == '\\') escaped += '\\';
+			escaped += c;
+		}
+		return escaped;
+	};
+
+	std::lock_guard lock(registryMutex);
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	const auto Separate = [&] {
+		if (!first) out << ",\n";
+		first = false;
+	};
+
+	char numbers[96];
+	for (const auto& buffer : buffers) {
+		if (buffer->session.load(std::memory_order_acquire) != recordedSession) continue;
+		const size_t count = buffer->count.load(std::memory_order_acquire);
+
+		Separate();
+		out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << buffer->tid << R"(,"args":{"name":")" << Escaped(buffer->name) << "\"}}";
+
+		for (size_t i = 0; i < count; i++) {
+			const Event& event = buffer->events[i];
+			if (event.startNs < startNs) continue; // begun before the recording, in the previous one
+
+			// complete ("X") events: begin and end in one record, microseconds since the recording started
+			std::snprintf(numbers, sizeof(numbers), "\"ts\":%.3f,\"dur\":%.3f", (double) (event.startNs - startNs) / 1000.0,
+			              (double) (event.endNs - event.startNs) / 1000.0);
+			Separate();
+			out << R"({"name":")" << Escaped(event.name) << R"(","ph":"X","pid":1,"tid":)" << buffer->tid << "," << numbers << "}";
+		}
+
+		if (const size_t dropped = buffer->dropped.load(std::memory_order_relaxed); dropped > 0) {
+			LOG("[Trace]: %s dropped %zu events (buffer full)", buffer->name.c_str(), dropped);
+		}
+	}
+	out << "]}\n";
+
+	return (bool) out;
+}
@@ -0,0 +1,76 @@
+//
+// Created by Tobiathan on 10/19/26.
+//
+
+#ifndef SENIORRESEARCH_TRACERECORDER_H
+#define SENIORRESEARCH_TRACERECORDER_H
+
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Records TRACE_SCOPE (and PROFILE_SCOPE) spans from any thread between Start and Stop, written out as Chrome Trace
+// Event JSON (opens in Perfetto / chrome://tracing). Each thread appends to its own fixed-size buffer without locking,
+// only the first event of a thread takes the registry lock. A thread that fills its buffer drops further events.
+class TraceRecorder {
+public:
+	class Scope {
+	public:
+		explicit Scope(const char* name) : name(name), startNs(IsRecording() ? Now() : 0) {}
+		~Scope() { if (startNs != 0) Push(name, startNs, Now()); }
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		const char* name; // string literal, only the pointer is kept
+		uint64_t startNs;
+	};
+
+	static void Start();
+	static std::string Stop(); // path of the written trace, empty if it couldn't be written
+	static void Toggle(); // hotkey, logs where the trace went
+
+	[[nodiscard]] static bool IsRecording() { return recording.load(std::memory_order_relaxed); }
+
+	static void NameThread(std::string name); // label for the calling thread's track
+
+	static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+	static constexpr const char* TRACE_DIRECTORY = "traces";
+
+private:
+	struct Event {
+		const char* name;
+		uint64_t startNs, endNs;
+	};
+	struct ThreadBuffer {
+		int tid;
+		std::string name;
+		std::atomic<uint32_t> session = 0; // recording the events belong to, the owning thread resets on a new one
+		std::atomic<size_t> count = 0, dropped = 0; // count is published after the event is written
+		std::unique_ptr<Event[]> events; // allocated by the owning thread on its first event, before count is published
+	};
+
+	static uint64_t Now();
+	static void Push(const char* name, uint64_t startNs, uint64_t endNs);
+	static ThreadBuffer& LocalBuffer();
+	static bool Write(const std::string& path, uint32_t session, uint64_t startNs);
+
+	static std::atomic<bool> recording;
+	static std::atomic<uint32_t> session;
+	static std::atomic<uint64_t> sessionStartNs;
+
+	static std::mutex registryMutex;
+	static std::vector<std::unique_ptr<ThreadBuffer>> buffers; // never freed, pool threads outlive recordings
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceRecorder::Scope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+
+#endif //SENIORRESEARCH_TRACERECORDER_H